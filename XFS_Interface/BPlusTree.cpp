@@ -7,6 +7,7 @@
 #include "define/errors.h"
 #include "disk_structures.h"
 #include "block_access.h"
+#include "Disk.h"
 
 using namespace std;
 
@@ -133,6 +134,10 @@ int BPlusTree::bPlusInsert(Attribute val, recId recordId) {
 
 	int attrType = (int) attrCatEntry[ATTRCAT_ATTR_TYPE_INDEX].nval;
 
+	// capacity of the index blocks, which depends on the block size of the disk
+	const int maxKeysLeaf = getMaxKeysLeaf(), middleIndexLeaf = maxKeysLeaf / 2;
+	const int maxKeysInternal = getMaxKeysInternal(), middleIndexInternal = maxKeysInternal / 2;
+
 	int blockType = getBlockType(blockNum);
 	HeadInfo blockHeader;
 	int num_of_entries, current_entryNumber;
@@ -206,7 +211,7 @@ int BPlusTree::bPlusInsert(Attribute val, recId recordId) {
 	}
 
 	//leaf block has not reached max limit
-	if (num_of_entries != MAX_KEYS_LEAF) {
+	if (num_of_entries != maxKeysLeaf) {
 
 		// increment blockHeader.numEntries and set this as header of block
 		blockHeader.numEntries = blockHeader.numEntries + 1;
@@ -249,7 +254,7 @@ int BPlusTree::bPlusInsert(Attribute val, recId recordId) {
 		 * - number of entries = 32
 		 * - right block = newRightBlkNum
 		 */
-		leftBlkHeader.numEntries = MIDDLE_INDEX_LEAF + 1;
+		leftBlkHeader.numEntries = middleIndexLeaf + 1;
 		leftBlkHeader.rblock = newRightBlkNum;
 		setHeader(&leftBlkHeader, leftBlkNum);
 
@@ -262,7 +267,7 @@ int BPlusTree::bPlusInsert(Attribute val, recId recordId) {
 		 * - parent block = parent block of leftBlkNum
 		 */
 		newRightBlkHeader.blockType = IND_LEAF;
-		newRightBlkHeader.numEntries = MIDDLE_INDEX_LEAF + 1;
+		newRightBlkHeader.numEntries = middleIndexLeaf + 1;
 		newRightBlkHeader.lblock = leftBlkNum;
 		newRightBlkHeader.pblock = leftBlkHeader.pblock;
 		newRightBlkHeader.rblock = prevRblock;
@@ -280,11 +285,11 @@ int BPlusTree::bPlusInsert(Attribute val, recId recordId) {
 
 		// set the first 32 entries of leftBlk as the first 32 entries of indices array
 		int indices_iter;
-		for (indices_iter = 0; indices_iter <= MIDDLE_INDEX_LEAF; indices_iter++) {
+		for (indices_iter = 0; indices_iter <= middleIndexLeaf; indices_iter++) {
 			setLeafEntry(indices[indices_iter], leftBlkNum, indices_iter);
 		}
 		// set the first 32 entries of newRightBlk as the next 32 entries of indices array
-		for (int rBlockIndexIter = 0; rBlockIndexIter <= MIDDLE_INDEX_LEAF; rBlockIndexIter++) {
+		for (int rBlockIndexIter = 0; rBlockIndexIter <= middleIndexLeaf; rBlockIndexIter++) {
 			setLeafEntry(indices[indices_iter], newRightBlkNum, rBlockIndexIter);
 			indices_iter++;
 		}
@@ -292,7 +297,7 @@ int BPlusTree::bPlusInsert(Attribute val, recId recordId) {
 		indices[0].attrVal.nval = 0;
 		indices[0].block = 0;
 		indices[0].slot = 0;
-		for (indices_iter = MIDDLE_INDEX_LEAF + 1; indices_iter < MAX_KEYS_LEAF; indices_iter++) {
+		for (indices_iter = middleIndexLeaf + 1; indices_iter < maxKeysLeaf; indices_iter++) {
 			setLeafEntry(indices[0], leftBlkNum, indices_iter);
 		}
 
@@ -301,7 +306,7 @@ int BPlusTree::bPlusInsert(Attribute val, recId recordId) {
 		 * this is attribute value which needs to be inserted in the parent block
 		 */
 		Index leafentry;
-		leafentry = getLeafEntry(leftBlkNum, MIDDLE_INDEX_LEAF);
+		leafentry = getLeafEntry(leftBlkNum, middleIndexLeaf);
 		Attribute newAttrVal;
 
 		if (attrType == NUMBER)
@@ -371,7 +376,7 @@ int BPlusTree::bPlusInsert(Attribute val, recId recordId) {
 				}
 
 				// parentBlock has not reached max limit.
-				if (parentHeader.numEntries != MAX_KEYS_INTERNAL) {
+				if (parentHeader.numEntries != maxKeysInternal) {
 					// increment parheader.numEntries and update it as header of parblk
 					parentHeader.numEntries = parentHeader.numEntries + 1;
 					setHeader(&parentHeader, parentBlock);
@@ -410,7 +415,7 @@ int BPlusTree::bPlusInsert(Attribute val, recId recordId) {
 					/* Update left block header
 					   * - number of entries = 50
 					   */
-					leftBlkHeader.numEntries = MIDDLE_INDEX_INTERNAL;
+					leftBlkHeader.numEntries = middleIndexInternal;
 					setHeader(&leftBlkHeader, leftBlkNum);
 
 					//load newRightBlkHeader
@@ -421,12 +426,12 @@ int BPlusTree::bPlusInsert(Attribute val, recId recordId) {
 					   * - parent block = parent block of leftBlkNum
 					   */
 					newRightBlkHeader.blockType = IND_INTERNAL;
-					newRightBlkHeader.numEntries = MIDDLE_INDEX_INTERNAL;
+					newRightBlkHeader.numEntries = middleIndexInternal;
 					newRightBlkHeader.pblock = leftBlkHeader.pblock;
 					setHeader(&newRightBlkHeader, newRightBlkNum);
 
 					// set the first 50 entries of leftBlk as the first 50 entries of internalEntries array
-					for (indices_iter = 0; indices_iter < MIDDLE_INDEX_INTERNAL; ++indices_iter) {
+					for (indices_iter = 0; indices_iter < middleIndexInternal; ++indices_iter) {
 						// TODO ::: REVIEW ::::
 //						if ((internal_entries[indices_iter].lChild == parentBlock) ||
 //						    (internal_entries[indices_iter].rChild == parentBlock)) {
@@ -443,16 +448,16 @@ int BPlusTree::bPlusInsert(Attribute val, recId recordId) {
 						setInternalEntry(internal_entries[indices_iter], leftBlkNum, indices_iter);
 					}
 
-					indices_iter = MIDDLE_INDEX_INTERNAL + 1;
+					indices_iter = middleIndexInternal + 1;
 					// set the first 50 entries of newRightBlk as the entries from 51 to 100 of internalEntries array
-					for (int j = 0; j < MIDDLE_INDEX_INTERNAL; ++j) {
+					for (int j = 0; j < middleIndexInternal; ++j) {
 						setInternalEntry(internal_entries[indices_iter], newRightBlkNum, j);
 						indices_iter++;
 					}
 
 					int childNum;
 					//iterate from 50 to 100:
-					for (int k = MIDDLE_INDEX_INTERNAL; k <= MAX_KEYS_INTERNAL; ++k) {
+					for (int k = middleIndexInternal; k <= maxKeysInternal; ++k) {
 						//assign the rchild block of ith index in internalEntries to childNum
 						childNum = internal_entries[k].rChild;
 
@@ -468,7 +473,7 @@ int BPlusTree::bPlusInsert(Attribute val, recId recordId) {
 					/* update newAttrval to the attribute value of 50th entry in the internalEntries array;
 					 * this is attribute value which needs to be inserted in the parent block.
 					 */
-					newAttrVal = internal_entries[MIDDLE_INDEX_INTERNAL].attrVal;
+					newAttrVal = internal_entries[middleIndexInternal].attrVal;
 
 				}
 			} else //if parent == -1 i.e root is split now
@@ -753,7 +758,7 @@ int BPlusTree::bPlusDestroy(int blockNum) {
 	HeadInfo header;
 
 	// if the block_num lies outside valid range
-	if (blockNum < 0 || blockNum >= DISK_BLOCKS) {
+	if (blockNum < 0 || blockNum >= Disk::getSuperBlock().numBlocks) {
 		return E_OUTOFBOUND;
 	}
 	header = getHeader(blockNum);
@@ -1,24 +1,30 @@
 #include <cstdio>
 #include <cstring>
 #include <string>
+#include <vector>
+#include <unistd.h>
 #include "define/constants.h"
 #include "Disk.h"
 #include "disk_structures.h"
 #include "block_access.h"
 
-int Disk::createDisk() {
+SuperBlock Disk::superBlock;
+bool Disk::superBlockLoaded = false;
+
+/*
+ * Creates an empty disk of diskSize bytes
+ * The file is extended with ftruncate, so the blocks read as zeroes without being written
+ * (the image is sparse and creating it takes the same time for any size)
+ */
+int Disk::createDisk(long long diskSize) {
 	FILE *disk = fopen(&DISK_PATH[0], "wb+");
 	if(disk == nullptr)
 		return FAILURE;
-	fseek(disk, 0, SEEK_SET);
 
-	// 16 MB
-	for(int i=0; i < DISK_SIZE; i++){
-		fputc(0,disk);
-	}
+	int ret = ftruncate(fileno(disk), diskSize);
 
 	fclose(disk);
-	return SUCCESS;
+	return ret == 0 ? SUCCESS : FAILURE;
 }
 
 Disk::~Disk() {
@@ -27,50 +33,139 @@ Disk::~Disk() {
 
 int Disk::readBlock(unsigned char *block, int blockNum) {
 	FILE *disk = fopen(&DISK_PATH[0], "rb");
-	const int offset = blockNum * BLOCK_SIZE;
+	const long offset = (long) blockNum * getBlockSize();
 	fseek(disk, offset, SEEK_SET);
-	fread(block, BLOCK_SIZE, 1, disk);
+	fread(block, getBlockSize(), 1, disk);
 	fclose(disk);
 }
 
 int Disk::writeBlock(unsigned char *block, int blockNum) {
 	FILE *disk = fopen(&DISK_PATH[0], "rb+");
-	int offset = blockNum * BLOCK_SIZE;
+	long offset = (long) blockNum * getBlockSize();
 	fseek(disk, offset, SEEK_SET);
-	fwrite(block, BLOCK_SIZE, 1, disk);
+	fwrite(block, getBlockSize(), 1, disk);
 	fclose(disk);
 }
 
+DiskFile::DiskFile() {
+	disk = fopen(&DISK_PATH[0], "rb+");
+}
+
+DiskFile::~DiskFile() {
+	if (disk != nullptr)
+		fclose(disk);
+}
+
+int DiskFile::readBlock(unsigned char *block, int blockNum) {
+	if (disk == nullptr || blockNum < 0 || blockNum >= Disk::getSuperBlock().numBlocks)
+		return FAILURE;
+	fseek(disk, (long) blockNum * Disk::getBlockSize(), SEEK_SET);
+	if (fread(block, Disk::getBlockSize(), 1, disk) != 1)
+		return FAILURE;
+	return SUCCESS;
+}
+
+int DiskFile::writeBlock(unsigned char *block, int blockNum) {
+	if (disk == nullptr || blockNum < 0 || blockNum >= Disk::getSuperBlock().numBlocks)
+		return FAILURE;
+	fseek(disk, (long) blockNum * Disk::getBlockSize(), SEEK_SET);
+	if (fwrite(block, Disk::getBlockSize(), 1, disk) != 1)
+		return FAILURE;
+	return SUCCESS;
+}
+
+int DiskFile::readBlockAllocationMap(unsigned char *blockAllocationMap) {
+	if (disk == nullptr)
+		return FAILURE;
+	fseek(disk, Disk::getBlockAllocationMapOffset(0), SEEK_SET);
+	if (fread(blockAllocationMap, Disk::getSuperBlock().numBlocks, 1, disk) != 1)
+		return FAILURE;
+	return SUCCESS;
+}
+
+int DiskFile::writeBlockAllocationMap(unsigned char *blockAllocationMap) {
+	if (disk == nullptr)
+		return FAILURE;
+	fseek(disk, Disk::getBlockAllocationMapOffset(0), SEEK_SET);
+	if (fwrite(blockAllocationMap, Disk::getSuperBlock().numBlocks, 1, disk) != 1)
+		return FAILURE;
+	return SUCCESS;
+}
+
 /*
- * Formats the disk
- * Set the reserved_blocks entries in block allocation map
- * Set Relcat and Attrcat
+ * Returns the geometry of the disk from its superblock (read once, and set again by formatDisk)
+ * A disk without a superblock has DISK_BLOCKS blocks of BLOCK_SIZE bytes with the block allocation map in blocks 0 to 3
  */
-void Disk::formatDisk() {
-	FILE *disk = fopen(&DISK_PATH[0], "wb+");
-	const int reserved_blocks = 6;
-	const int offset = DISK_SIZE;
+SuperBlock Disk::getSuperBlock() {
+	if (!superBlockLoaded) {
+		FILE *disk = fopen(&DISK_PATH[0], "rb");
+		if (disk == nullptr || fread(&superBlock, sizeof(superBlock), 1, disk) != 1 ||
+		    memcmp(superBlock.magic, DISK_MAGIC, sizeof(superBlock.magic)) != 0 ||
+		    superBlock.blockSize < MIN_BLOCK_SIZE || superBlock.blockSize > MAX_BLOCK_SIZE) {
+			superBlock.blockSize = BLOCK_SIZE;
+			superBlock.numBlocks = DISK_BLOCKS;
+			superBlock.bmapBlock = 0;
+			superBlock.bmapBlocks = BLOCK_ALLOCATION_MAP_SIZE;
+		}
+		if (disk != nullptr)
+			fclose(disk);
+		superBlockLoaded = true;
+	}
+	return superBlock;
+}
+
+/*
+ * Returns the size in bytes of the blocks of the disk
+ */
+int Disk::getBlockSize() {
+	return getSuperBlock().blockSize;
+}
+
+/*
+ * Returns the offset in the disk file of the block allocation map entry of the block
+ */
+long Disk::getBlockAllocationMapOffset(int blockNum) {
+	return (long) getSuperBlock().bmapBlock * getBlockSize() + blockNum;
+}
 
-	fseek(disk, 0, SEEK_SET);
-	unsigned char blockAllocationMap[BLOCK_SIZE * BLOCK_ALLOCATION_MAP_SIZE];
+/*
+ * Formats the disk created by createDisk() with numBlocks blocks of blockSize bytes
+ *      - Block 0 is the superblock, blocks 1 to 3 are reserved
+ *      - Blocks 4 and 5 are the first blocks of Relcat and Attrcat
+ *      - The block allocation map, one entry per block, takes the blocks from block 6
+ * Only these blocks are written, the rest of the disk is already zero
+ */
+void Disk::formatDisk(int numBlocks, int blockSize) {
+	FILE *disk = fopen(&DISK_PATH[0], "rb+");
+	const int bmapBlocks = (numBlocks + blockSize - 1) / blockSize;
+	const int reserved_blocks = BLOCK_ALLOCATION_MAP_BLOCK + bmapBlocks;
+
+	unsigned char block[MAX_BLOCK_SIZE];
+	memset(block, 0, blockSize);
+	memcpy(superBlock.magic, DISK_MAGIC, sizeof(superBlock.magic));
+	superBlock.blockSize = blockSize;
+	superBlock.numBlocks = numBlocks;
+	superBlock.bmapBlock = BLOCK_ALLOCATION_MAP_BLOCK;
+	superBlock.bmapBlocks = bmapBlocks;
+	superBlockLoaded = true;
+	memcpy(block, &superBlock, sizeof(superBlock));
+	fseek(disk, (long) SUPERBLOCK * blockSize, SEEK_SET);
+	fwrite(block, blockSize, 1, disk);
+
+	// Entries past the last block are never allocated
+	std::vector<unsigned char> blockAllocationMap((size_t) bmapBlocks * blockSize, (unsigned char) UNUSED_BLK);
 
 	// reserved_blocks Entries in Block Allocation Map (Used)
 	for (int i = 0; i < reserved_blocks; i++) {
-		if (i >= 0 && i <= 3)
-            blockAllocationMap[i] = (unsigned char) BMAP;
-		else
+		if (i == RELCAT_BLOCK || i == ATTRCAT_BLOCK)
             blockAllocationMap[i] = (unsigned char) REC;
+		else
+            blockAllocationMap[i] = (unsigned char) BMAP;
 	}
 
 	// Remaining Entries in Block Allocation Map are marked Unused
-	for (int i = reserved_blocks; i < BLOCK_SIZE * BLOCK_ALLOCATION_MAP_SIZE; i++)
-        blockAllocationMap[i] = (unsigned char) UNUSED_BLK;
-	fwrite(blockAllocationMap, BLOCK_SIZE * BLOCK_ALLOCATION_MAP_SIZE, 1, disk);
-
-	// Remaining Locations of Disk initialised to 0
-	for (int i = BLOCK_SIZE * BLOCK_ALLOCATION_MAP_SIZE; i < offset; i++) {
-		fputc(0, disk);
-	}
+	fseek(disk, (long) BLOCK_ALLOCATION_MAP_BLOCK * blockSize, SEEK_SET);
+	fwrite(blockAllocationMap.data(), blockAllocationMap.size(), 1, disk);
 	fclose(disk);
 
     Disk::add_disk_metainfo();
@@ -104,7 +199,7 @@ void Disk::add_disk_metainfo() {
         else
             slot_map[slotNum] = SLOT_UNOCCUPIED;
     }
-    setSlotmap(slot_map, SLOTMAP_SIZE_RELCAT_ATTRCAT, BLOCK_ALLOCATION_MAP_SIZE);
+    setSlotmap(slot_map, SLOTMAP_SIZE_RELCAT_ATTRCAT, RELCAT_BLOCK);
 
     /*
      * Create and Add 2 Records into Block 4 (Relation Catalog)
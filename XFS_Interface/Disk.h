@@ -1,16 +1,41 @@
 #ifndef NITCBASE_DISK_H
 #define NITCBASE_DISK_H
 
+#include <cstdio>
+#include "define/constants.h"
+#include "disk_structures.h"
 
 class Disk {
 public:
 	Disk();
 	~Disk();
-	static int createDisk();
+	static int createDisk(long long diskSize = DISK_SIZE);
 	static int readBlock(unsigned char *block, int blockNum); // Use this wherever a block is being written (eg. ba_insert)
 	static int writeBlock(unsigned char *block, int blockNum); // Use this wherever a block is being read
-	static void formatDisk();
+	static void formatDisk(int numBlocks = DISK_BLOCKS, int blockSize = BLOCK_SIZE);
     static void add_disk_metainfo();
+	static SuperBlock getSuperBlock();
+	static int getBlockSize();
+	static long getBlockAllocationMapOffset(int blockNum);
+private:
+	static SuperBlock superBlock;
+	static bool superBlockLoaded;
+};
+
+/*
+ * An open handle to the disk file for commands that go through many blocks
+ * (Disk::readBlock and Disk::writeBlock open and close the file on every call)
+ */
+class DiskFile {
+public:
+	DiskFile();
+	~DiskFile();
+	int readBlock(unsigned char *block, int blockNum);
+	int writeBlock(unsigned char *block, int blockNum);
+	int readBlockAllocationMap(unsigned char *blockAllocationMap); // one entry for each of the blocks of the disk
+	int writeBlockAllocationMap(unsigned char *blockAllocationMap);
+private:
+	FILE *disk;
 };
 
 
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstdio>
 #include <string>
 #include <cstring>
@@ -8,6 +9,7 @@
 #include "schema.h"
 #include "OpenRelTable.h"
 #include "BPlusTree.h"
+#include "Disk.h"
 
 int getFreeRecBlock();
 
@@ -477,11 +479,11 @@ int ba_renameattr(char relName[ATTR_SIZE], char oldName[ATTR_SIZE], char newName
  */
 int getBlockType(int blocknum) {
 	FILE *disk = fopen(&DISK_PATH[0], "rb");
-	fseek(disk, 0, SEEK_SET);
-	unsigned char blockAllocationMap[4 * BLOCK_SIZE];
-	fread(blockAllocationMap, 4 * BLOCK_SIZE, 1, disk);
+	fseek(disk, Disk::getBlockAllocationMapOffset(blocknum), SEEK_SET);
+	unsigned char blockType;
+	fread(&blockType, 1, 1, disk);
 	fclose(disk);
-	return (int32_t) (blockAllocationMap[blocknum]);
+	return (int32_t) blockType;
 }
 
 /*
@@ -490,7 +492,7 @@ int getBlockType(int blocknum) {
 HeadInfo getHeader(int blockNum) {
 	HeadInfo header;
 	FILE *disk = fopen(&DISK_PATH[0], "rb");
-	fseek(disk, blockNum * BLOCK_SIZE, SEEK_SET);
+	fseek(disk, (long) blockNum * Disk::getBlockSize(), SEEK_SET);
 	fread(&header, 32, 1, disk);
 	fclose(disk);
 	return header;
@@ -501,7 +503,7 @@ HeadInfo getHeader(int blockNum) {
  */
 void setHeader(struct HeadInfo *header, int blockNum) {
 	FILE *disk = fopen(&DISK_PATH[0], "rb+");
-	fseek(disk, blockNum * BLOCK_SIZE, SEEK_SET);
+	fseek(disk, (long) blockNum * Disk::getBlockSize(), SEEK_SET);
 	fwrite(header, 32, 1, disk);
 	fclose(disk);
 }
@@ -511,9 +513,9 @@ void setHeader(struct HeadInfo *header, int blockNum) {
  */
 void getSlotmap(unsigned char *SlotMap, int blockNum) {
 	FILE *disk = fopen(&DISK_PATH[0], "rb+");
-	fseek(disk, blockNum * BLOCK_SIZE, SEEK_SET);
+	fseek(disk, (long) blockNum * Disk::getBlockSize(), SEEK_SET);
 	RecBlock R;
-	fread(&R, BLOCK_SIZE, 1, disk);
+	fread(&R, Disk::getBlockSize(), 1, disk);
 	int numSlots = R.numSlots;
 	memcpy(SlotMap, R.slotMap_Records, numSlots);
 	fclose(disk);
@@ -524,27 +526,35 @@ void getSlotmap(unsigned char *SlotMap, int blockNum) {
  */
 void setSlotmap(unsigned char *SlotMap, int no_of_slots, int blockNum) {
 	FILE *disk = fopen(&DISK_PATH[0], "rb+");
-	fseek(disk, blockNum * BLOCK_SIZE + 32, SEEK_SET);
+	fseek(disk, (long) blockNum * Disk::getBlockSize() + 32, SEEK_SET);
 	fwrite(SlotMap, no_of_slots, 1, disk);
 	fclose(disk);
 }
 
+/*
+ * Allocates the first unused block of the disk for a block of type block_type
+ * The block allocation map is scanned in chunks of BLOCK_SIZE entries and only the changed entry is written
+ */
 int getFreeBlock(int block_type) {
 
 	FILE *disk = fopen(&DISK_PATH[0], "rb+");
-	fseek(disk, 0, SEEK_SET);
-	unsigned char blockAllocationMap[4 * BLOCK_SIZE];
-	fread(blockAllocationMap, 4 * BLOCK_SIZE, 1, disk);
-	for (int iter = 0; iter < 4 * BLOCK_SIZE; iter++) {
-		if ((int32_t) (blockAllocationMap[iter]) == UNUSED_BLK) {
-			blockAllocationMap[iter] = (unsigned char) block_type;
-			fseek(disk, 0, SEEK_SET);
-			fwrite(blockAllocationMap, BLOCK_SIZE * 4, 1, disk);
+	const int numBlocks = Disk::getSuperBlock().numBlocks;
+	unsigned char blockAllocationMap[BLOCK_SIZE];
+	fseek(disk, Disk::getBlockAllocationMapOffset(0), SEEK_SET);
+	for (int first = 0; first < numBlocks; first += BLOCK_SIZE) {
+		int entries = std::min(BLOCK_SIZE, numBlocks - first);
+		fread(blockAllocationMap, entries, 1, disk);
+		unsigned char *entry = (unsigned char *) memchr(blockAllocationMap, UNUSED_BLK, entries);
+		if (entry != nullptr) {
+			int iter = first + (int) (entry - blockAllocationMap);
+			fseek(disk, Disk::getBlockAllocationMapOffset(iter), SEEK_SET);
+			fputc((unsigned char) block_type, disk);
 			fclose(disk);
 			return iter;
 		}
 	}
 
+	fclose(disk);
 	return FAILURE;
 }
 
@@ -552,24 +562,7 @@ int getFreeBlock(int block_type) {
  *
  */
 int getFreeRecBlock() {
-	// TODO: Title for this
-	FILE *disk = fopen(&DISK_PATH[0], "rb+");
-	fseek(disk, 0, SEEK_SET);
-
-	unsigned char blockAllocationMap[4 * BLOCK_SIZE];
-	fread(blockAllocationMap, 4 * BLOCK_SIZE, 1, disk);
-
-	for (int iter = 0; iter < 4 * BLOCK_SIZE; iter++) {
-		if ((int32_t) (blockAllocationMap[iter]) == UNUSED_BLK) {
-			blockAllocationMap[iter] = (unsigned char) REC;
-			fseek(disk, 0, SEEK_SET);
-			fwrite(blockAllocationMap, BLOCK_SIZE * 4, 1, disk);
-			fclose(disk);
-			return iter;
-		}
-	}
-
-	return FAILURE;
+	return getFreeBlock(REC);
 }
 
 /* Finds a free slot either from :
@@ -680,8 +673,8 @@ int getRecord(Attribute *rec, int blockNum, int slotNum) {
 
 	if (BlockType == REC) {
 		RecBlock R;
-		fseek(disk, blockNum * BLOCK_SIZE, SEEK_SET);
-		fread(&R, BLOCK_SIZE, 1, disk);
+		fseek(disk, (long) blockNum * Disk::getBlockSize(), SEEK_SET);
+		fread(&R, Disk::getBlockSize(), 1, disk);
 		int numSlots = R.numSlots;
 
 		if (R.slotMap_Records[slotNum] == SLOT_UNOCCUPIED)
@@ -722,12 +715,12 @@ int setRecord(Attribute *rec, int blockNum, int slotNum) {
 
 	if (BlockType == REC) {
 		/* offset :
-		 *          size of blocks coming before current block ( = blockNum * BLOCK_SIZE ) +
+		 *          size of blocks coming before current block ( = blockNum * Disk::getBlockSize() ) +
 		 *          header size ( = 32 ) +
 		 *          slot_map size ( = numSlots ) +
 		 *          size of records coming before current record ( = slotNum * numAttrs * ATTR_SIZE )
 		 */
-		fseek(disk, blockNum * BLOCK_SIZE + 32 + numOfSlots + slotNum * numAttrs * ATTR_SIZE, SEEK_SET);
+		fseek(disk, (long) blockNum * Disk::getBlockSize() + 32 + numOfSlots + slotNum * numAttrs * ATTR_SIZE, SEEK_SET);
 		fwrite(rec, numAttrs * ATTR_SIZE, 1, disk);
 		fclose(disk);
 		return SUCCESS;
@@ -909,12 +902,12 @@ int deleteBlock(int blockNum) {
 	disk = fopen(&DISK_PATH[0], "rb+");
 
 	/* Clear the data present in the block */
-	fseek(disk, BLOCK_SIZE * blockNum, SEEK_SET);
-	for (int i = 0; i < BLOCK_SIZE; i++)
+	fseek(disk, (long) Disk::getBlockSize() * blockNum, SEEK_SET);
+	for (int i = 0; i < Disk::getBlockSize(); i++)
 		fputc(0, disk);
 
 	/* Mark this block as UNUSED in the Block Allocation Map */
-	fseek(disk, blockNum, SEEK_SET);
+	fseek(disk, Disk::getBlockAllocationMapOffset(blockNum), SEEK_SET);
 	fputc((unsigned char) UNUSED_BLK, disk);
 	fclose(disk);
 
@@ -950,7 +943,7 @@ int deleteRelCatEntry(recId relcat_recid, Attribute relcat_rec[6]) {
 	setRecord(relcat_rec, 4, 1);
 
 	FILE *disk = fopen(&DISK_PATH[0], "rb+");
-	fseek(disk, (relcat_recid.block) * BLOCK_SIZE + HEADER_SIZE + SLOTMAP_SIZE_RELCAT_ATTRCAT +
+	fseek(disk, (long) (relcat_recid.block) * Disk::getBlockSize() + HEADER_SIZE + SLOTMAP_SIZE_RELCAT_ATTRCAT +
 	            relcat_recid.slot * NO_OF_ATTRS_RELCAT_ATTRCAT * ATTR_SIZE, SEEK_SET);
 	for (int i = 0; i < 16 * 6; i++)
 		fputc(0, disk);
@@ -969,7 +962,7 @@ int deleteRelCatEntry(recId relcat_recid, Attribute relcat_rec[6]) {
 int deleteAttrCatEntry(recId attrcat_recid) {
 	/* Clear the Attribute Catalog Record present in the given (Slot & Block) of the Disk */
 	FILE *disk = fopen(&DISK_PATH[0], "rb+");
-	fseek(disk, (attrcat_recid.block) * BLOCK_SIZE + HEADER_SIZE + SLOTMAP_SIZE_RELCAT_ATTRCAT +
+	fseek(disk, (long) (attrcat_recid.block) * Disk::getBlockSize() + HEADER_SIZE + SLOTMAP_SIZE_RELCAT_ATTRCAT +
 	            (attrcat_recid.slot) * NO_OF_ATTRS_RELCAT_ATTRCAT * ATTR_SIZE, SEEK_SET);
 	for (int i = 0; i < ATTR_SIZE * NO_OF_ATTRS_RELCAT_ATTRCAT; i++)
 		fputc(0, disk);
@@ -1031,10 +1024,27 @@ int compareAttributes(union Attribute attr1, union Attribute attr2, int attrType
 	}
 }
 
+/*
+ * Maximum number of keys in a leaf index block of the disk (63 for 2048 byte blocks)
+ * Leaf entries do not overlap, which gives an odd count for every block size so that a split is even
+ */
+int getMaxKeysLeaf() {
+	return (Disk::getBlockSize() - HEADER_SIZE) / LEAF_ENTRY_SIZE;
+}
+
+/*
+ * Maximum number of keys in an internal index block of the disk (100 for 2048 byte blocks)
+ * An entry shares its rChild with the lChild of the next one, so it takes 20 bytes after the first lChild
+ * The count is kept even so that a split leaves the same number of keys on both sides
+ */
+int getMaxKeysInternal() {
+	return (Disk::getBlockSize() - HEADER_SIZE - LCHILD_SIZE) / (ATTR_SIZE + RCHILD_SIZE) & ~1;
+}
+
 InternalEntry getInternalEntry(int block, int entryNum) {
 	InternalEntry rec;
 	FILE *disk = fopen(&DISK_PATH[0], "rb");
-	fseek(disk, block * BLOCK_SIZE + HEADER_SIZE + entryNum * (LCHILD_SIZE+ATTR_SIZE), SEEK_SET);
+	fseek(disk, (long) block * Disk::getBlockSize() + HEADER_SIZE + entryNum * (LCHILD_SIZE+ATTR_SIZE), SEEK_SET);
 
 	fread(&rec.lChild, 4, 1, disk);
 	fread(&rec.attrVal, 16, 1, disk);
@@ -1070,7 +1080,7 @@ void setInternalEntry(InternalEntry internalEntry, int block, int offset) {
 //	}
 
 	FILE *disk = fopen(&DISK_PATH[0], "rb+");
-	fseek(disk, block * BLOCK_SIZE + HEADER_SIZE + offset * (LCHILD_SIZE+ATTR_SIZE), SEEK_SET);
+	fseek(disk, (long) block * Disk::getBlockSize() + HEADER_SIZE + offset * (LCHILD_SIZE+ATTR_SIZE), SEEK_SET);
 	fwrite(&internalEntry.lChild, 4, 1, disk);
 	fwrite(&internalEntry.attrVal, 16, 1, disk);
 	fwrite(&internalEntry.rChild, 4, 1, disk);
@@ -1080,7 +1090,7 @@ void setInternalEntry(InternalEntry internalEntry, int block, int offset) {
 Index getLeafEntry(int leaf, int offset) {
 	Index rec;
 	FILE *disk = fopen(&DISK_PATH[0], "rb");
-	fseek(disk, leaf * BLOCK_SIZE + HEADER_SIZE + offset * LEAF_ENTRY_SIZE, SEEK_SET);
+	fseek(disk, (long) leaf * Disk::getBlockSize() + HEADER_SIZE + offset * LEAF_ENTRY_SIZE, SEEK_SET);
 	fread(&rec, sizeof(rec), 1, disk);
 	fclose(disk);
 	return rec;
@@ -1088,7 +1098,7 @@ Index getLeafEntry(int leaf, int offset) {
 
 void setLeafEntry(Index rec, int leaf, int offset) {
 	FILE *disk = fopen(&DISK_PATH[0], "rb+");
-	fseek(disk, leaf * BLOCK_SIZE + HEADER_SIZE + offset * LEAF_ENTRY_SIZE, SEEK_SET);
+	fseek(disk, (long) leaf * Disk::getBlockSize() + HEADER_SIZE + offset * LEAF_ENTRY_SIZE, SEEK_SET);
 	fwrite(&rec, sizeof(rec), 1, disk);
 	fclose(disk);
 }
@@ -29,6 +29,8 @@ int getBlockType(int blocknum);
 int compareAttributes(union Attribute attr1, union Attribute attr2, int attrType);
 int deleteBlock(int blockNum);
 
+int getMaxKeysLeaf();
+int getMaxKeysInternal();
 InternalEntry getInternalEntry(int block, int entryNum);
 void setInternalEntry(InternalEntry internalEntry, int block, int offset);
 Index getLeafEntry(int leaf, int offset);
@@ -14,8 +14,11 @@
 // Path to Batch_Execution_Files directory inside the Files directory
 #define BATCH_FILES_PATH "../Files/Batch_Execution_Files/"
 
-// Size of Block in bytes
+// Size of Block in bytes of a disk without a superblock (the default block size)
 #define BLOCK_SIZE 2048
+// Smallest and largest block size of a disk (a power of two chosen by FDISK)
+#define MIN_BLOCK_SIZE 2048
+#define MAX_BLOCK_SIZE 16384
 // Size of an attribute in bytes
 #define ATTR_SIZE 16
 // Size of Disk in bytes
@@ -39,15 +42,24 @@
 // Size of an Leaf Index Entry in the Leaf Index Block (in bytes)
 #define LEAF_ENTRY_SIZE 32
 
-// Number of block in disk
+// Number of block in a disk without a superblock (the default disk size)
 #define DISK_BLOCKS 8192
+// Largest number of blocks of a disk (block numbers are 32 bit)
+#define MAX_DISK_BLOCKS 0x7fffffff
 // Total number of blocks available in the Buffer (Capacity of the Buffer in blocks)
 #define BUFFER_CAPACITY 32
 // Maximum number of relations allowed to be open and cached in Cache Layer.
 #define MAX_OPEN 12
-// Number of blocks given for Block Allocation Map in the disk
+// Number of blocks given for Block Allocation Map in a disk without a superblock
 #define BLOCK_ALLOCATION_MAP_SIZE 4
 
+// Disk block number of the superblock, which records the size of the disk
+#define SUPERBLOCK 0
+// Magic bytes at the start of the superblock
+#define DISK_MAGIC "NITCBASE"
+// Disk block number of the first block of the Block Allocation Map (after the catalogs)
+#define BLOCK_ALLOCATION_MAP_BLOCK 6
+
 // Number of attributes present in one entry / record of the Relation Catalog
 #define RELCAT_NO_ATTRS 6
 // Number of attributes present in one entry / record of the Attribute Catalog
@@ -159,16 +171,6 @@
 // Index for Offset attribute of an attribute catalog entry
 #define ATTRCAT_OFFSET_INDEX 5
 
-// Global variables for B+ Tree Layer
-// Maximum number of keys allowed in an Internal Node of a B+ tree
-#define MAX_KEYS_INTERNAL 100
-// Index of the middle element in an Internal Node of a B+ tree
-#define MIDDLE_INDEX_INTERNAL 50
-// Maximum number of keys allowed in a Leaf Node of a B+ tree
-#define MAX_KEYS_LEAF 63
-// Index of the middle element in a Leaf Node of a B+ tree
-#define MIDDLE_INDEX_LEAF 31
-
 // Name strings for Relation Catalog and Attribute Catalog (as it is stored in the Relation catalog)
 #define RELCAT_RELNAME "RELATIONCAT"
 #define ATTRCAT_RELNAME "ATTRIBUTECAT"
@@ -189,4 +191,9 @@
 #define ATTRCAT_ATTR_ROOT_BLOCK "RootBlock"
 #define ATTRCAT_ATTR_OFFSET "Offset"
 
+// Number of bytes of csv text buffered by export before it is written to the file
+#define EXPORT_BUFFER_SIZE (1 << 20)
+// Number of data lines of a csv file from which import infers the attribute types
+#define IMPORT_SAMPLE_LINES 100
+
 #endif  // NITCBASE_CONSTANTS_H
\ No newline at end of file
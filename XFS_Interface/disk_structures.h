@@ -16,6 +16,20 @@ typedef struct indexId {
 	int index;
 } indexId;
 
+/*
+ * Block 0 of the disk, written by FDISK
+ * Blocks are blockSize bytes, a power of two from MIN_BLOCK_SIZE to MAX_BLOCK_SIZE
+ * The block allocation map has one entry per block and takes bmapBlocks blocks starting at bmapBlock
+ * (a disk formatted before superblocks has DISK_BLOCKS blocks with the map in blocks 0 to 3)
+ */
+typedef struct SuperBlock {
+	char magic[8];
+	int32_t blockSize;
+	int32_t numBlocks;
+	int32_t bmapBlock;
+	int32_t bmapBlocks;
+} SuperBlock;
+
 typedef struct RelCatEntry {
 	char rel_name[ATTR_SIZE];
 	int num_attr;
@@ -43,7 +57,7 @@ typedef struct RecBlock {
 	int32_t numAttrs;
 	int32_t numSlots;
 	unsigned char reserved[4];
-	unsigned char slotMap_Records[BLOCK_SIZE - 104];
+	unsigned char slotMap_Records[MAX_BLOCK_SIZE - 104];  // only the first Disk::getBlockSize() bytes of the struct are read
 	unsigned char unused[72];
 } RecBlock;
 
@@ -1,7 +1,17 @@
 #include <iostream>
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
+#include <charconv>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "external_fs_commands.h"
+#include "Disk.h"
 #include "disk_structures.h"
 #include "block_access.h"
 #include "OpenRelTable.h"
@@ -18,6 +28,8 @@ void writeHeaderToFile(FILE *fp_export, HeadInfo h);
 
 void writeAttributeToFile(FILE *fp, Attribute attribute, int type, int lastLineFlag);
 
+void formatRecordBlock(const unsigned char *block, int numOfAttrs, const int *attrType, string &out);
+
 
 void dump_relcat() {
 	string relation_catalog = "relation_catalog";
@@ -118,11 +130,11 @@ void dump_attrcat() {
 }
 
 void dumpBlockAllocationMap() {
-	FILE *disk = fopen(&DISK_PATH[0], "rb+");
-	fseek(disk, 0, SEEK_SET);
-	unsigned char blockAllocationMap[4 * BLOCK_SIZE];
-	fread(blockAllocationMap, 4 * BLOCK_SIZE, 1, disk);
-	fclose(disk);
+	vector<unsigned char> blockAllocationMap(Disk::getSuperBlock().numBlocks);
+	{
+		DiskFile disk;
+		disk.readBlockAllocationMap(blockAllocationMap.data());
+	}
 
 	int blockNum;
 	char s[ATTR_SIZE];
@@ -135,16 +147,13 @@ void dumpBlockAllocationMap() {
 
 	FILE *fp_export = fopen(fileName, "w");
 
-	for (blockNum = 0; blockNum < 4; blockNum++) {
-		fputs("Block ", fp_export);
-		sprintf(s, "%d", blockNum);
-		fputs(s, fp_export);
-		fputs(": Block Allocation Map\n", fp_export);
-	}
-	for (blockNum = 4; blockNum < 8192; blockNum++) {
+	for (blockNum = 0; blockNum < (int) blockAllocationMap.size(); blockNum++) {
 		fputs("Block ", fp_export);
 		sprintf(s, "%d", blockNum);
 		fputs(s, fp_export);
+		if ((int32_t) (blockAllocationMap[blockNum]) == BMAP) {
+			fputs(": Block Allocation Map\n", fp_export);
+		}
 		if ((int32_t) (blockAllocationMap[blockNum]) == UNUSED_BLK) {
 			fputs(": Unused Block\n", fp_export);
 		}
@@ -177,104 +186,388 @@ void ls() {
 	std::cout << "\n";
 }
 
-int importRelation(char *fileName) {
-
-	FILE *file = fopen(fileName, "r");
+/*
+ * A csv file mapped into memory, unmapped when it goes out of scope
+ */
+typedef struct MappedFile {
+	const char *data = nullptr;
+	size_t size = 0;
 
-	/*
-	 *  GET ATTRIBUTE NAMES FROM FIRST LINE OF FILE
-	 */
-	char *firstLine = (char *) malloc(sizeof(char));
-	int numOfCharactersInLine = 1;
-	int currentCharacter, previousCharacter;
-	int numOfAttributes = 1;
-	previousCharacter = ',';
-	while ((currentCharacter = fgetc(file)) != '\n') {
-		if (currentCharacter == EOF)
+	~MappedFile() {
+		if (data != nullptr)
+			munmap((void *) data, size);
+	}
+} MappedFile;
+
+/*
+ * A non empty line of a csv file (without leading whitespace and the line terminator)
+ */
+typedef struct CsvLine {
+	const char *begin;
+	const char *end;
+	int lineNumber;
+} CsvLine;
+
+/*
+ * Splits a csv line into its comma separated fields
+ */
+static void splitFields(const CsvLine &line, vector<pair<const char *, const char *>> &fields) {
+	fields.clear();
+	const char *field = line.begin;
+	while (true) {
+		const char *comma = (const char *) memchr(field, ',', line.end - field);
+		fields.emplace_back(field, comma != nullptr ? comma : line.end);
+		if (comma == nullptr)
 			break;
-		while (currentCharacter == ' ' || currentCharacter == '\t' || currentCharacter == '\n') {
-			currentCharacter = fgetc(file);
+		field = comma + 1;
+	}
+}
+
+/*
+ * Parses a field as a number (only the first ATTR_SIZE - 1 characters are read, as in a record)
+ */
+static bool parseNumber(const char *begin, const char *end, double *val) {
+	end = min(end, begin + ATTR_SIZE - 1);
+	while (begin < end && isspace((unsigned char) *begin))
+		begin++;
+	while (end > begin && isspace((unsigned char) end[-1]))
+		end--;
+	if (end - begin > 1 && begin[0] == '+' && begin[1] != '-')
+		begin++;
+
+	from_chars_result result = from_chars(begin, end, *val);
+	return result.ec == errc() && result.ptr == end && begin < end;
+}
+
+/*
+ * Takes the first unused block in the block allocation map for a block of the given type
+ * (the map is checked for enough free blocks before an import allocates any)
+ */
+static int allocateBlock(vector<unsigned char> &blockAllocationMap, int blockType) {
+	unsigned char *entry = (unsigned char *) memchr(blockAllocationMap.data(), UNUSED_BLK, blockAllocationMap.size());
+	*entry = (unsigned char) blockType;
+	return entry - blockAllocationMap.data();
+}
+
+/*
+ * Number of blocks of a B+ tree built bottom-up over the given number of index entries
+ */
+static int indexBlocksNeeded(int numEntries) {
+	const int maxKeysLeaf = getMaxKeysLeaf(), maxKeysInternal = getMaxKeysInternal();
+	int numBlocks = max(1, (numEntries + maxKeysLeaf - 1) / maxKeysLeaf);
+	int total = numBlocks;
+	while (numBlocks > 1) {
+		numBlocks = (numBlocks + maxKeysInternal) / (maxKeysInternal + 1);
+		total += numBlocks;
+	}
+	return total;
+}
+
+/*
+ * Builds a B+ tree bottom-up from index entries sorted on the attribute and writes its blocks
+ *      - the entries are spread evenly over as few leaves as possible, linked through lblock and rblock
+ *      - each level of internal blocks is built over the level below it in the same way, the key
+ *        between two children being the largest key of the left child
+ * Returns the root block
+ */
+static int buildIndex(DiskFile &disk, vector<unsigned char> &blockAllocationMap, const vector<Index> &entries) {
+	vector<int> blocks;             // blocks of the tree, in the order they are built
+	vector<HeadInfo> headers;       // their headers, written with the blocks once the parents are known
+	vector<unsigned char> images;   // their contents, blockSize bytes each
+	vector<int> level;              // positions in blocks of the level being built
+	vector<Attribute> maxKeys;      // largest key in the subtree of each block of the level
+	const int blockSize = Disk::getBlockSize();
+	const int maxKeysLeaf = getMaxKeysLeaf(), maxKeysInternal = getMaxKeysInternal();
+
+	auto newBlock = [&](int blockType) {
+		HeadInfo header;
+		memset(&header, 0, sizeof(header));
+		header.blockType = blockType;
+		header.pblock = -1;
+		header.lblock = -1;
+		header.rblock = -1;
+		headers.push_back(header);
+		blocks.push_back(allocateBlock(blockAllocationMap, blockType));
+		images.resize(images.size() + blockSize, 0);
+		return (int) blocks.size() - 1;
+	};
+
+	int numEntries = entries.size();
+	int numLeaves = max(1, (numEntries + maxKeysLeaf - 1) / maxKeysLeaf);
+	for (int i = 0, next = 0; i < numLeaves; i++) {
+		int count = numEntries / numLeaves + (i < numEntries % numLeaves ? 1 : 0);
+		int leaf = newBlock(IND_LEAF);
+
+		headers[leaf].numEntries = count;
+		if (!level.empty()) {
+			headers[leaf].lblock = blocks[level.back()];
+			headers[level.back()].rblock = blocks[leaf];
 		}
-		if (currentCharacter == EOF)
-			break;
-		if (currentCharacter == ',') {
-			numOfAttributes++;
-			if (previousCharacter == currentCharacter) {
-				cout << "Null values are not allowed in attribute names\n";
-				return FAILURE;
+		memcpy(&images[(size_t) leaf * blockSize + HEADER_SIZE], entries.data() + next, (size_t) count * LEAF_ENTRY_SIZE);
+
+		next += count;
+		level.push_back(leaf);
+		Attribute maxKey;
+		memset(&maxKey, 0, sizeof(maxKey));
+		if (count > 0)
+			maxKey = entries[next - 1].attrVal;
+		maxKeys.push_back(maxKey);
+	}
+
+	while (level.size() > 1) {
+		int numChildren = level.size();
+		int numBlocks = (numChildren + maxKeysInternal) / (maxKeysInternal + 1);
+
+		vector<int> upperLevel;
+		vector<Attribute> upperMaxKeys;
+		for (int i = 0, next = 0; i < numBlocks; i++) {
+			int count = numChildren / numBlocks + (i < numChildren % numBlocks ? 1 : 0);
+			int internal = newBlock(IND_INTERNAL);
+
+			headers[internal].numEntries = count - 1;
+			// entries are lChild, attrVal, rChild with each rChild shared as the lChild of the next entry
+			unsigned char *entry = &images[(size_t) internal * blockSize + HEADER_SIZE];
+			for (int j = 0; j < count - 1; j++, entry += LCHILD_SIZE + ATTR_SIZE) {
+				int32_t lChild = blocks[level[next + j]];
+				int32_t rChild = blocks[level[next + j + 1]];
+				memcpy(entry, &lChild, LCHILD_SIZE);
+				memcpy(entry + LCHILD_SIZE, &maxKeys[next + j], ATTR_SIZE);
+				memcpy(entry + LCHILD_SIZE + ATTR_SIZE, &rChild, RCHILD_SIZE);
 			}
+			for (int j = 0; j < count; j++)
+				headers[level[next + j]].pblock = blocks[internal];
+
+			next += count;
+			upperLevel.push_back(internal);
+			upperMaxKeys.push_back(maxKeys[next - 1]);
 		}
-		firstLine[numOfCharactersInLine - 1] = currentCharacter;
-		numOfCharactersInLine++;
-		firstLine = (char *) realloc(firstLine, (numOfCharactersInLine) * sizeof(char));
-		previousCharacter = currentCharacter;
+		level.swap(upperLevel);
+		maxKeys.swap(upperMaxKeys);
 	}
 
-	if (previousCharacter == ',') {
-		cout << "Null values are not allowed in attribute names\n";
-		return FAILURE;
+	for (size_t i = 0; i < blocks.size(); i++) {
+		memcpy(&images[i * blockSize], &headers[i], sizeof(HeadInfo));
+		disk.writeBlock(&images[i * blockSize], blocks[i]);
 	}
+	return blocks[level[0]];
+}
 
-    if (numOfAttributes > 125) {
-        return E_MAXATTRS;
-    }
+/*
+ * Writes the records of a newly created (empty) relation to the disk in bulk, together with the
+ * B+ trees of the given attributes
+ *      - the block allocation map is read once, and written back once all the blocks are written
+ *      - record blocks are filled completely, in the order of the records, and linked
+ *      - the index entries of each attribute are sorted and its B+ tree is built bottom-up
+ * The relation catalog entry and the attribute catalog entries of the indexed attributes are updated
+ * Returns E_DISKFULL, without allocating any block, if the disk does not have enough free blocks
+ */
+static int bulkLoadRelation(int relId, int numAttrs, const int attrTypes[], const vector<Attribute> &records,
+                            const vector<int> &indexAttrs, char attrNames[][ATTR_SIZE]) {
+	Attribute relCatEntry[6];
+	getRelCatEntry(relId, relCatEntry);
+	int numSlots = (int) relCatEntry[RELCAT_NO_SLOTS_PER_BLOCK_INDEX].nval;
+	int numRecords = records.size() / numAttrs;
+	int numRecBlocks = (numRecords + numSlots - 1) / numSlots;
+
+	vector<int> recBlocks(numRecBlocks);
+	vector<int> rootBlocks(indexAttrs.size());
+	{
+		DiskFile disk;
+		vector<unsigned char> blockAllocationMap(Disk::getSuperBlock().numBlocks);
+		if (disk.readBlockAllocationMap(blockAllocationMap.data()) != SUCCESS)
+			return FAILURE;
 
-	firstLine[numOfCharactersInLine - 1] = '\0';
-	int currentCharIndexInLine = 0, attrOffsetIterator, attributeIndexIterator;
-	char attributeNames[numOfAttributes][ATTR_SIZE];
-	attrOffsetIterator = 0;
-	while (attrOffsetIterator < numOfAttributes) {
-		attributeIndexIterator = 0;
-		while (((firstLine[currentCharIndexInLine] != ',') && (firstLine[currentCharIndexInLine] != '\0')) &&
-		       (attributeIndexIterator < ATTR_SIZE - 1)) {
-			if (checkIfInvalidCharacter(firstLine[currentCharIndexInLine])) {
-				cout << "Invalid character : '" << firstLine[currentCharIndexInLine] << "' in attribute name\n";
-				return FAILURE;
+		int blocksNeeded = numRecBlocks + indexAttrs.size() * indexBlocksNeeded(numRecords);
+		int freeBlocks = count(blockAllocationMap.begin(), blockAllocationMap.end(), (unsigned char) UNUSED_BLK);
+		if (blocksNeeded > freeBlocks)
+			return E_DISKFULL;
+
+		for (int i = 0; i < numRecBlocks; i++)
+			recBlocks[i] = allocateBlock(blockAllocationMap, REC);
+
+		unsigned char block[MAX_BLOCK_SIZE];
+		for (int i = 0; i < numRecBlocks; i++) {
+			int first = i * numSlots;
+			int numEntries = min(numSlots, numRecords - first);
+
+			HeadInfo header;
+			memset(&header, 0, sizeof(header));
+			header.blockType = REC;
+			header.pblock = -1;
+			header.lblock = i > 0 ? recBlocks[i - 1] : -1;
+			header.rblock = i + 1 < numRecBlocks ? recBlocks[i + 1] : -1;
+			header.numEntries = numEntries;
+			header.numAttrs = numAttrs;
+			header.numSlots = numSlots;
+
+			memset(block, 0, Disk::getBlockSize());
+			memcpy(block, &header, sizeof(header));
+			memset(block + HEADER_SIZE, SLOT_OCCUPIED, numEntries);
+			memset(block + HEADER_SIZE + numEntries, SLOT_UNOCCUPIED, numSlots - numEntries);
+			memcpy(block + HEADER_SIZE + numSlots, records.data() + (size_t) first * numAttrs,
+			       (size_t) numEntries * numAttrs * ATTR_SIZE);
+			disk.writeBlock(block, recBlocks[i]);
+		}
+
+		vector<Index> entries(numRecords);
+		for (size_t i = 0; i < indexAttrs.size(); i++) {
+			int offset = indexAttrs[i];
+			int attrType = attrTypes[offset];
+			for (int recNum = 0; recNum < numRecords; recNum++) {
+				memset(&entries[recNum], 0, sizeof(Index));
+				entries[recNum].attrVal = records[(size_t) recNum * numAttrs + offset];
+				entries[recNum].block = recBlocks[recNum / numSlots];
+				entries[recNum].slot = recNum % numSlots;
 			}
-			attributeNames[attrOffsetIterator][attributeIndexIterator++] = firstLine[currentCharIndexInLine++];
+			stable_sort(entries.begin(), entries.end(), [attrType](const Index &a, const Index &b) {
+				return compareAttributes(a.attrVal, b.attrVal, attrType) < 0;
+			});
+			rootBlocks[i] = buildIndex(disk, blockAllocationMap, entries);
 		}
-		if (attributeIndexIterator == ATTR_SIZE - 1) {
-			while (firstLine[currentCharIndexInLine] != ',')
-				currentCharIndexInLine++;
+
+		disk.writeBlockAllocationMap(blockAllocationMap.data());
+	}
+
+	relCatEntry[RELCAT_NO_RECORDS_INDEX].nval = numRecords;
+	relCatEntry[RELCAT_FIRST_BLOCK_INDEX].nval = numRecBlocks > 0 ? recBlocks.front() : -1;
+	relCatEntry[RELCAT_LAST_BLOCK_INDEX].nval = numRecBlocks > 0 ? recBlocks.back() : -1;
+	setRelCatEntry(relId, relCatEntry);
+
+	for (size_t i = 0; i < indexAttrs.size(); i++) {
+		Attribute attrCatEntry[6];
+		getAttrCatEntry(relId, attrNames[indexAttrs[i]], attrCatEntry);
+		attrCatEntry[ATTRCAT_ROOT_BLOCK_INDEX].nval = rootBlocks[i];
+		setAttrCatEntry(relId, attrNames[indexAttrs[i]], attrCatEntry);
+	}
+	return SUCCESS;
+}
+
+/*
+ * Imports a csv file as a new relation named after the file
+ *      - the file is mapped into memory and every line is parsed before the relation is created
+ *      - attribute types are inferred from the first IMPORT_SAMPLE_LINES data lines: an attribute is a
+ *        NUMBER if all its sampled values are numbers
+ *      - the first line holds the attribute names, unless its values fit the inferred types (with at
+ *        least one NUMBER attribute), in which case it is data and the attributes are named Attr1, Attr2...
+ *      - the records are written in bulk and B+ trees are built for the attributes in indexAttrs
+ */
+int importRelation(char *fileName, int numIndexAttrs, char indexAttrs[][ATTR_SIZE]) {
+	MappedFile file;
+	int fd = open(fileName, O_RDONLY);
+	if (fd < 0) {
+		cout << "Invalid file path or file does not exist" << endl;
+		return FAILURE;
+	}
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0) {
+		void *data = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data != MAP_FAILED) {
+			file.data = (const char *) data;
+			file.size = fileStat.st_size;
+			madvise(data, fileStat.st_size, MADV_SEQUENTIAL);
 		}
-		attributeNames[attrOffsetIterator][attributeIndexIterator] = '\0';
-		attrOffsetIterator++;
-		currentCharIndexInLine++;
 	}
-	currentCharIndexInLine = 0;
+	close(fd);
 
 	/*
-	 *  INFER ATTRIBUTE TYPES FROM SECOND LINE OF FILE
+	 *  SPLIT THE FILE INTO LINES, SKIPPING BLANK LINES
 	 */
-	char *secondLine = (char *) malloc(sizeof(char));
-	numOfCharactersInLine = 1;
-	while ((currentCharacter = fgetc(file)) != '\n') {
-		if (currentCharacter == EOF)
-			break;
-		secondLine[numOfCharactersInLine - 1] = currentCharacter;
-		numOfCharactersInLine++;
-		secondLine = (char *) realloc(secondLine, (numOfCharactersInLine) * sizeof(char));
+	vector<CsvLine> lines;
+	const char *fileEnd = file.data + file.size;
+	int lineNumber = 1;
+	for (const char *line = file.data; line < fileEnd; lineNumber++) {
+		const char *lineEnd = (const char *) memchr(line, '\n', fileEnd - line);
+		const char *nextLine = lineEnd != nullptr ? lineEnd + 1 : fileEnd;
+		if (lineEnd == nullptr)
+			lineEnd = fileEnd;
+		if (lineEnd > line && lineEnd[-1] == '\r')
+			lineEnd--;
+		while (line < lineEnd && (*line == ' ' || *line == '\t'))
+			line++;
+		if (line < lineEnd)
+			lines.push_back({line, lineEnd, lineNumber});
+		line = nextLine;
 	}
-	secondLine[numOfCharactersInLine - 1] = '\0';
-	currentCharIndexInLine = 0;
-	char secondLineFields[numOfAttributes][ATTR_SIZE];
+	if (lines.empty()) {
+		cout << "No attribute names found in file\n";
+		return FAILURE;
+	}
+
+	vector<pair<const char *, const char *>> fields;
+	splitFields(lines[0], fields);
+	int numOfAttributes = fields.size();
+	if (numOfAttributes > 125) {
+		return E_MAXATTRS;
+	}
+	vector<pair<const char *, const char *>> firstLineFields = fields;
+
+	/*
+	 *  INFER ATTRIBUTE TYPES FROM A SAMPLE OF THE DATA LINES
+	 */
 	int attrTypes[numOfAttributes];
-	attrOffsetIterator = 0;
-	while (attrOffsetIterator < numOfAttributes) {
-		attributeIndexIterator = 0;
-		while (((secondLine[currentCharIndexInLine] != ',') && (secondLine[currentCharIndexInLine] != '\0')) &&
-		       (attributeIndexIterator < ATTR_SIZE - 1)) {
-			secondLineFields[attrOffsetIterator][attributeIndexIterator++] = secondLine[currentCharIndexInLine++];
+	int numSampleLines = min((int) lines.size(), IMPORT_SAMPLE_LINES + 1);
+	for (int attr = 0; attr < numOfAttributes; attr++)
+		attrTypes[attr] = numSampleLines > 1 ? NUMBER : STRING;
+	for (int lineIndex = 1; lineIndex < numSampleLines; lineIndex++) {
+		splitFields(lines[lineIndex], fields);
+		if (fields.size() != numOfAttributes)
+			continue;
+		double ignore;
+		for (int attr = 0; attr < numOfAttributes; attr++) {
+			if (attrTypes[attr] == NUMBER && !parseNumber(fields[attr].first, fields[attr].second, &ignore))
+				attrTypes[attr] = STRING;
+		}
+	}
+
+	bool hasHeader = true;
+	for (int attr = 0; attr < numOfAttributes; attr++) {
+		if (attrTypes[attr] == NUMBER) {
+			double ignore;
+			hasHeader = !parseNumber(firstLineFields[attr].first, firstLineFields[attr].second, &ignore);
+			if (hasHeader)
+				break;
+		}
+	}
+
+	/*
+	 *  GET ATTRIBUTE NAMES FROM FIRST LINE OF FILE
+	 */
+	char attributeNames[numOfAttributes][ATTR_SIZE];
+	for (int attr = 0; attr < numOfAttributes; attr++) {
+		if (!hasHeader) {
+			sprintf(attributeNames[attr], "Attr%d", attr + 1);
+			continue;
+		}
+		int length = 0;
+		for (const char *ch = firstLineFields[attr].first; ch < firstLineFields[attr].second && length < ATTR_SIZE - 1; ch++) {
+			if (*ch == ' ' || *ch == '\t')
+				continue;
+			if (checkIfInvalidCharacter(*ch)) {
+				cout << "Invalid character : '" << *ch << "' in attribute name\n";
+				return FAILURE;
+			}
+			attributeNames[attr][length++] = *ch;
+		}
+		if (length == 0) {
+			cout << "Null values are not allowed in attribute names\n";
+			return FAILURE;
 		}
-		secondLineFields[attrOffsetIterator][attributeIndexIterator] = '\0';
-		attrTypes[attrOffsetIterator] = checkAttrTypeOfValue(secondLineFields[attrOffsetIterator]);
+		attributeNames[attr][length] = '\0';
+	}
 
-		attrOffsetIterator++;
-		currentCharIndexInLine++;
+	vector<int> indexOffsets;
+	for (int i = 0; i < numIndexAttrs; i++) {
+		int offset = 0;
+		while (offset < numOfAttributes && strcmp(attributeNames[offset], indexAttrs[i]) != 0)
+			offset++;
+		if (offset == numOfAttributes) {
+			return E_ATTRNOTEXIST;
+		}
+		if (find(indexOffsets.begin(), indexOffsets.end(), offset) == indexOffsets.end())
+			indexOffsets.push_back(offset);
 	}
 
 	// EXTRACT RELATION NAME FROM FILE PATH
-	currentCharIndexInLine = 0;
 	char relationName[ATTR_SIZE];
 	int fileNameIterator = strlen(fileName) - 1;
 	while (fileName[fileNameIterator] != '.') {
@@ -300,6 +593,47 @@ int importRelation(char *fileName) {
 		return E_CREATETEMP;
 	}
 
+	/*
+	 *  PARSE THE RECORDS
+	 */
+	int firstDataLine = hasHeader ? 1 : 0;
+	int numRecords = lines.size() - firstDataLine;
+	vector<Attribute> records((size_t) numRecords * numOfAttributes);
+	memset(records.data(), 0, records.size() * sizeof(Attribute));
+
+	for (int recNum = 0; recNum < numRecords; recNum++) {
+		const CsvLine &line = lines[firstDataLine + recNum];
+		splitFields(line, fields);
+		if (fields.size() != numOfAttributes) {
+			cout << "Mismatch in number of attributes\n";
+			return FAILURE;
+		}
+
+		Attribute *record = &records[(size_t) recNum * numOfAttributes];
+		for (int attr = 0; attr < numOfAttributes; attr++) {
+			const char *field = fields[attr].first;
+			size_t length = fields[attr].second - field;
+			if (length == 0) {
+				cout << "Null values are not allowed in attribute fields\n";
+				return FAILURE;
+			}
+
+			if (attrTypes[attr] == NUMBER) {
+				if (!parseNumber(field, fields[attr].second, &record[attr].nval))
+					return E_ATTRTYPEMISMATCH;
+			} else {
+				length = min(length, (size_t) ATTR_SIZE - 1);
+				for (size_t i = 0; i < length; i++) {
+					if (checkIfInvalidCharacter(field[i])) {
+						cout << "Invalid character at line " << line.lineNumber << " in file \n";
+						return FAILURE;
+					}
+				}
+				memcpy(record[attr].sval, field, length);
+			}
+		}
+	}
+
 	// CREATE RELATION
 	int ret;
 	ret = createRel(relationName, numOfAttributes, attributeNames, attrTypes);
@@ -311,125 +645,21 @@ int importRelation(char *fileName) {
 	// OPEN RELATION
 	int relId = OpenRelTable::openRelation(relationName);
 	if (relId == E_CACHEFULL) {
+		ba_delete(relationName);
 		cout << "Import not possible as openRel failed\n";
 		return FAILURE;
 	}
 
-	// Skip first line containing attribute names
-	file = fopen(fileName, "r");
-	while ((currentCharacter = fgetc(file)) != '\n')
-		continue;
-
-	char *currentLineAsCharArray = (char *) malloc(sizeof(char));
-	numOfCharactersInLine = 1;
-
-	int lineNumber = 2;
-	while (true) {
-		currentCharacter = fgetc(file);
-		if (currentCharacter == EOF)
-			break;
-		while (currentCharacter == ' ' || currentCharacter == '\t' || currentCharacter == '\n') {
-			currentCharacter = fgetc(file);
-		}
-		if (currentCharacter == EOF)
-			break;
-		numOfCharactersInLine = 1;
-		int numOfFieldsInLine = 0;
-		previousCharacter = ',';
-
-
-		while ((currentCharacter != '\n') && (currentCharacter != EOF)) {
-
-			if (currentCharacter == ',')
-				numOfFieldsInLine++;
-			if (currentCharacter == previousCharacter && currentCharacter == ',') {
-				OpenRelTable::closeRelation(relId);
-				ba_delete(relationName);
-				cout << "Null values are not allowed in attribute fields\n";
-				return FAILURE;
-			}
-			currentLineAsCharArray[numOfCharactersInLine - 1] = currentCharacter;
-			numOfCharactersInLine++;
-			currentLineAsCharArray = (char *) realloc(currentLineAsCharArray, (numOfCharactersInLine) * sizeof(char));
-			previousCharacter = currentCharacter;
-
-			currentCharacter = fgetc(file);
-
-		}
-
-		if (previousCharacter == ',') {
-			OpenRelTable::closeRelation(relId);
-			ba_delete(relationName);
-
-			cout << "Null values are not allowed in attribute fields\n";
-			return FAILURE;
-		}
-		if (numOfAttributes != numOfFieldsInLine + 1) {
-			OpenRelTable::closeRelation(relId);
-			ba_delete(relationName);
-
-			cout << "Mismatch in number of attributes\n";
-			return FAILURE;
-		}
-		currentLineAsCharArray[numOfCharactersInLine - 1] = '\0';
-		currentCharIndexInLine = 0;
-
-		char attributesCharArray[numOfAttributes][ATTR_SIZE];
-		attrOffsetIterator = 0;
-		while (attrOffsetIterator < numOfAttributes) {
-			attributeIndexIterator = 0;
-
-			while (((currentLineAsCharArray[currentCharIndexInLine] != ',') &&
-			        (currentLineAsCharArray[currentCharIndexInLine] != '\0')) &&
-			       (attributeIndexIterator < ATTR_SIZE - 1)) {
-				attributesCharArray[attrOffsetIterator][attributeIndexIterator++] = currentLineAsCharArray[currentCharIndexInLine++];
-			}
-			if (attributeIndexIterator == ATTR_SIZE - 1) {
-				while (currentLineAsCharArray[currentCharIndexInLine] != ',')
-					currentCharIndexInLine++;
-			}
-			currentCharIndexInLine++;
-			attributesCharArray[attrOffsetIterator][attributeIndexIterator] = '\0';
-
-			attrOffsetIterator++;
-		}
-
-		Attribute record[numOfAttributes];
-		int retValue = constructRecordFromAttrsArray(numOfAttributes, record, attributesCharArray, attrTypes);
-
-		if (retValue == E_ATTRTYPEMISMATCH) {
-			OpenRelTable::closeRelation(relId);
-			ba_delete(relationName);
-
-			return E_ATTRTYPEMISMATCH;
-		} else if (retValue == E_INVALID) {
-			OpenRelTable::closeRelation(relId);
-			ba_delete(relationName);
-
-			cout << "Invalid character at line " << lineNumber << " in file \n";
-			return FAILURE;
-		}
-
-		int retVal = ba_insert(relId, record);
-
-		if (retVal != SUCCESS) {
-			OpenRelTable::closeRelation(relId);
-			ba_delete(relationName);
-
-			cout << "Insert failed at line"<< lineNumber << " in file"  << endl;
-			return retVal;
-		}
-		if (currentCharacter == EOF)
-			break;
-
-		lineNumber++;
-	}
+	ret = bulkLoadRelation(relId, numOfAttributes, attrTypes, records, indexOffsets, attributeNames);
 	OpenRelTable::closeRelation(relId);
-	fclose(file);
+	if (ret != SUCCESS) {
+		ba_delete(relationName);
+		return ret;
+	}
 	return SUCCESS;
 }
 
-int exportRelation(char *relname, char *filename) {
+int exportRelation(char *relname, char *filename, bool parallel) {
 	FILE *fp_export = fopen(filename, "w");
 
 	if (!fp_export) {
@@ -498,53 +728,102 @@ int exportRelation(char *relname, char *filename) {
 
 	fputs("\n", fp_export);
 
-	int block_num = firstBlock;
-	int num_slots;
-	int num_attrs;
-
 	/*
-	 * Iterate over the record blocks of this relation
-	 * Linked list traversal
+	 * Iterate over the record blocks of this relation (linked list traversal),
+	 * reading each block once through a single handle to the disk
 	 */
-	while (block_num != -1) {
-		headInfo = getHeader(block_num);
+	DiskFile disk;
+	const int blockSize = Disk::getBlockSize();
+	unsigned char block[MAX_BLOCK_SIZE];
+	int block_num = firstBlock;
 
-		num_slots = headInfo.numSlots;
-		num_attrs = headInfo.numAttrs;
-		nextRecBlock_Attrcat = headInfo.rblock;
+	if (!parallel) {
+		// Format the records block by block, writing them out once the buffer fills up
+		string out;
+		out.reserve(2 * EXPORT_BUFFER_SIZE);
+		while (block_num != -1) {
+			if (disk.readBlock(block, block_num) != SUCCESS) {
+				fclose(fp_export);
+				return FAILURE;
+			}
+			memcpy(&headInfo, block, HEADER_SIZE);
 
-		unsigned char slotmap[num_slots];
-		getSlotmap(slotmap, block_num);
-
-		Attribute A[num_attrs];
-		slotNum = 0;
-		// Go through all slots and write the record entry to file
-		for (slotNum = 0; slotNum < num_slots; slotNum++) {
-			if (slotmap[slotNum] == SLOT_OCCUPIED) {
-				getRecord(A, block_num, slotNum);
-				char s[ATTR_SIZE];
-				for (int l = 0; l < numOfAttrs; l++) {
-					if (attrType[l] == NUMBER) {
-						sprintf(s, "%f", A[l].nval);
-						fputs(s, fp_export);
-					}
-					if (attrType[l] == STRING) {
-						fputs(A[l].sval, fp_export);
-					}
-					if (l != numOfAttrs - 1)
-						fputs(",", fp_export);
-				}
-				fputs("\n", fp_export);
+			formatRecordBlock(block, numOfAttrs, attrType, out);
+			if (out.size() >= EXPORT_BUFFER_SIZE) {
+				fwrite(out.data(), 1, out.size(), fp_export);
+				out.clear();
+			}
+
+			block_num = headInfo.rblock;
+		}
+		fwrite(out.data(), 1, out.size(), fp_export);
+	} else {
+		// Read all the record blocks, then format disjoint ranges of them on separate threads
+		vector<unsigned char> blocks;
+		while (block_num != -1) {
+			if (disk.readBlock(block, block_num) != SUCCESS) {
+				fclose(fp_export);
+				return FAILURE;
 			}
+			memcpy(&headInfo, block, HEADER_SIZE);
+			blocks.insert(blocks.end(), block, block + blockSize);
+			block_num = headInfo.rblock;
 		}
 
-		block_num = nextRecBlock_Attrcat;
+		int numBlocks = blocks.size() / blockSize;
+		int numThreads = min<int>(max(1u, thread::hardware_concurrency()), numBlocks);
+
+		vector<string> parts(numThreads);
+		vector<thread> threads;
+		for (int t = 0; t < numThreads; t++) {
+			threads.emplace_back([&, t]() {
+				for (int b = numBlocks * t / numThreads; b < numBlocks * (t + 1) / numThreads; b++)
+					formatRecordBlock(&blocks[(size_t) b * blockSize], numOfAttrs, attrType, parts[t]);
+			});
+		}
+		for (thread &th : threads)
+			th.join();
+
+		for (string &part : parts)
+			fwrite(part.data(), 1, part.size(), fp_export);
 	}
 
 	fclose(fp_export);
 	return SUCCESS;
 }
 
+/*
+ * Appends the records in the occupied slots of a record block to out, one csv line per record
+ * (numbers are written in their shortest form that reads back to the same value)
+ */
+void formatRecordBlock(const unsigned char *block, int numOfAttrs, const int *attrType, string &out) {
+	HeadInfo headInfo;
+	memcpy(&headInfo, block, HEADER_SIZE);
+
+	const unsigned char *slotmap = block + HEADER_SIZE;
+	const unsigned char *records = slotmap + headInfo.numSlots;
+	char number[32];
+
+	for (int slotNum = 0; slotNum < headInfo.numSlots; slotNum++) {
+		if (slotmap[slotNum] != SLOT_OCCUPIED)
+			continue;
+
+		const unsigned char *record = records + slotNum * headInfo.numAttrs * ATTR_SIZE;
+		for (int l = 0; l < numOfAttrs; l++) {
+			Attribute A;
+			memcpy(&A, record + l * ATTR_SIZE, ATTR_SIZE);
+			if (attrType[l] == NUMBER) {
+				to_chars_result result = to_chars(number, number + sizeof(number), A.nval);
+				out.append(number, result.ptr - number);
+			}
+			if (attrType[l] == STRING) {
+				out.append(A.sval, strnlen(A.sval, ATTR_SIZE));
+			}
+			out += (l != numOfAttrs - 1) ? ',' : '\n';
+		}
+	}
+}
+
 
 void writeHeaderToFile(FILE *fp_export, HeadInfo h) {
 	writeHeaderFieldToFile(fp_export, h.blockType);
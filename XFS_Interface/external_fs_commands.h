@@ -1,12 +1,14 @@
 #ifndef NITCBASE_EXTERNAL_FS_COMMANDS_H
 #define NITCBASE_EXTERNAL_FS_COMMANDS_H
 
+#include "define/constants.h"
+
 void dump_relcat();
 void dump_attrcat();
 void dumpBlockAllocationMap();
 void ls();
-int importRelation(char *fileName);
-int exportRelation(char *relname, char *filename);
+int importRelation(char *fileName, int numIndexAttrs = 0, char indexAttrs[][ATTR_SIZE] = nullptr);
+int exportRelation(char *relname, char *filename, bool parallel = false);
 bool checkIfInvalidCharacter(char character);
 
 #endif //NITCBASE_EXTERNAL_FS_COMMANDS_H
@@ -133,8 +133,43 @@ int regexMatchAndExecute(const string input_command) {
 		cout << " successfully to: " << filePath << endl;
 
 	} else if (regex_match(input_command, fdisk)) {
-		Disk::createDisk();
-		Disk::formatDisk();
+		regex_search(input_command, m, fdisk);
+		int blockSize = BLOCK_SIZE;
+		if (m[4].matched) {
+			blockSize = stoi(m[5]);
+			if (m[6].length() > 0)
+				blockSize = blockSize > MAX_BLOCK_SIZE ? MAX_BLOCK_SIZE + 1 : blockSize << 10;
+			if (blockSize < MIN_BLOCK_SIZE || blockSize > MAX_BLOCK_SIZE || (blockSize & (blockSize - 1)) != 0) {
+				cout << "Block size should be a power of two from " << MIN_BLOCK_SIZE << " to " << MAX_BLOCK_SIZE << " bytes" << endl;
+				return FAILURE;
+			}
+		}
+		const long long maxDiskSize = (long long) MAX_DISK_BLOCKS * blockSize;
+		long long diskSize = DISK_SIZE;
+		if (m[1].matched) {
+			diskSize = stoll(m[2]);
+			string unit = m[3];
+			if (!unit.empty()) {
+				int shift = toupper(unit[0]) == 'K' ? 10 : toupper(unit[0]) == 'M' ? 20 : 30;
+				diskSize = diskSize > (maxDiskSize >> shift) ? maxDiskSize + 1 : diskSize << shift;
+			}
+		}
+		if (diskSize < DISK_SIZE) {
+			cout << "Disk size should be at least " << DISK_SIZE / (1024 * 1024) << "MB" << endl;
+			return FAILURE;
+		}
+		if (diskSize > maxDiskSize) {
+			cout << "Disk size should be at most " << maxDiskSize / (1024 * 1024 * 1024) << "GB" << endl;
+			return FAILURE;
+		}
+		// round up to a whole number of blocks
+		diskSize = (diskSize + blockSize - 1) / blockSize * blockSize;
+
+		if (Disk::createDisk(diskSize) != SUCCESS) {
+			cout << "Unable to create the disk" << endl;
+			return FAILURE;
+		}
+		Disk::formatDisk(diskSize / blockSize, blockSize);
 		// Re-initialize OpenRelTable
 		OpenRelTable::initializeOpenRelationTable();
 		cout << "Disk formatted" << endl;
@@ -183,7 +218,14 @@ int regexMatchAndExecute(const string input_command) {
 		fclose(file);
 		string Filename = m[1];
 
-		int ret = importRelation(filepath);
+		vector<string> index_tokens = extract_tokens(m[3]);
+		int index_count = index_tokens.size();
+		char index_attrs[index_count][ATTR_SIZE];
+		for (int attr_no = 0; attr_no < index_count; attr_no++) {
+			string_to_char_array(index_tokens[attr_no], index_attrs[attr_no], ATTR_SIZE - 1);
+		}
+
+		int ret = importRelation(filepath, index_count, index_attrs);
 		if (ret == SUCCESS) {
 			cout << "Imported from " << complete_filepath << " successfully" << endl;
 		} else {
@@ -202,7 +244,8 @@ int regexMatchAndExecute(const string input_command) {
 		char fileName[filePath.length() + 1];
 		string_to_char_array(filePath, fileName, filePath.length() + 1);
 
-		int ret = exportRelation(relname, fileName);
+		bool parallel = m[3].matched;
+		int ret = exportRelation(relname, fileName, parallel);
 
 		if (ret == SUCCESS) {
 			cout << "Exported ";
@@ -898,9 +941,9 @@ int executeCommandsFromFile(const string fileName) {
 }
 
 void display_help() {
-	printf("fdisk \n\t -Format disk \n\n");
-	printf("import <filename> \n\t -loads relations from the UNIX filesystem to the XFS disk. \n\n");
-	printf("export <tablename> <filename>.csv \n\t -export a relation from XFS disk to UNIX file system. \n\n");
+	printf("fdisk [size[K|M|G]] [blocksize 2K|4K|8K|16K] \n\t -Format disk (of the given size, 16MB by default, with blocks of the given size, 2K by default; both are recorded in the superblock in block 0). \n\n");
+	printf("import <filename> [index on attr1, attr2, ...] \n\t -loads relations from the UNIX filesystem to the XFS disk (building B+ trees on the given attributes). \n\n");
+	printf("export <tablename> <filename>.csv [parallel] \n\t -export a relation from XFS disk to UNIX file system (parallel formats the records on several threads). \n\n");
 	printf("print table <tablename> \n\t-print all the rows of a relation in the XFS disk. \n\n");
 	printf("ls \n\t  -list the names of all relations in the xfs disk. \n\n");
 	printf("echo <any message> \n\t  -echo back the given string. \n\n");
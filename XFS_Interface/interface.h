@@ -5,12 +5,12 @@
 
 /* External File System Commands */
 std::regex help("\\s*HELP\\s*;?", std::regex_constants::icase);
-std::regex fdisk("\\s*FDISK\\s*;?", std::regex_constants::icase);
+std::regex fdisk("\\s*FDISK(\\s+([0-9]{1,12})\\s*([KMG]?)B?)?(\\s+BLOCKSIZE\\s+([0-9]{1,5})\\s*(K?)B?)?\\s*;?", std::regex_constants::icase);
 std::regex dump_rel("\\s*DUMP\\s+RELCAT\\s*;?", std::regex_constants::icase);
 std::regex dump_attr("\\s*DUMP\\s+ATTRCAT\\s*;?", std::regex_constants::icase);
 std::regex dump_bmap("\\s*DUMP\\s+BMAP\\s*;?", std::regex_constants::icase);
-std::regex imp("\\s*IMPORT\\s+([a-zA-Z0-9_-]+\\.csv)\\s*;?", std::regex_constants::icase);
-std::regex exprt("\\s*EXPORT\\s+([A-Za-z0-9_-]+)\\s+([a-zA-Z0-9_-]+\\.csv)\\s*;?", std::regex_constants::icase);
+std::regex imp("\\s*IMPORT\\s+([a-zA-Z0-9_-]+\\.csv)(\\s+INDEX\\s+ON\\s+([a-zA-Z0-9_-]+(\\s*,\\s*[a-zA-Z0-9_-]+)*))?\\s*;?", std::regex_constants::icase);
+std::regex exprt("\\s*EXPORT\\s+([A-Za-z0-9_-]+)\\s+([a-zA-Z0-9_-]+\\.csv)(\\s+PARALLEL)?\\s*;?", std::regex_constants::icase);
 std::regex schema("\\s*SCHEMA\\s+([A-Za-z0-9_-]+)\\s*;?", std::regex_constants::icase);
 std::regex list_all("\\s*LS\\s*;?", std::regex_constants::icase);
 std::regex ex("\\s*EXIT\\s*\\s*;?", std::regex_constants::icase);
@@ -1,7 +1,19 @@
 #include "Algebra.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
 #include <cstring>
 #include <iostream>
+#include <iterator>
+#include <queue>
+#include <thread>
+#include <vector>
 
 
 // will return if a string can be parsed as a floating point number
@@ -22,16 +34,43 @@ bool isNumber(char* str) {
 	return ret == 1 && len == strlen(str);
 }
 
+/* Records waiting to be appended to a target relation by BlockAccess::bulkInsert() */
+struct InsertBatch {
+    int relId;
+    int numAttrs;
+    std::vector<Attribute> records;
+
+    InsertBatch(int relId, int numAttrs) : relId(relId), numAttrs(numAttrs) {}
+};
+
+/* appends the queued records of the batch to its relation */
+static int flushBatch(InsertBatch &batch) {
+    int numRecords = batch.records.size() / batch.numAttrs, numInserted;
+    int ret = BlockAccess::bulkInsert(batch.relId, batch.records.data(), numRecords, &numInserted);
+    batch.records.clear();
+    return ret;
+}
+
+/* queues a record for insertion, flushing the batch once it holds BULK_INSERT_BATCH records */
+static int batchInsert(InsertBatch &batch, Attribute record[]) {
+    batch.records.insert(batch.records.end(), record, record + batch.numAttrs);
+    if (batch.records.size() < (size_t)BULK_INSERT_BATCH * batch.numAttrs) {
+        return SUCCESS;
+    }
+    return flushBatch(batch);
+}
+
 
 /*
     This function creates a new target relation with attributes as that of source relation. 
     It inserts the records of source relation which satisfies the given condition into the 
-    target Relation. 
+    target Relation. The search stops once `limit` records have been selected.
 */
-int Algebra::select(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], char attr[ATTR_SIZE], int op, char strVal[ATTR_SIZE]) {
-    // get the srcRel's rel-id (let it be srcRelid), using OpenRelTable::getRelId()
+int Algebra::select(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], char attr[ATTR_SIZE], int op, char strVal[ATTR_SIZE],
+    int limit) {
+    // get the srcRel's rel-id (let it be srcRelid), using OpenRelTable::pinRel()
     // if srcRel is not open in open relation table, return E_RELNOTOPEN
-    int srcRelId = OpenRelTable::getRelId(srcRel);
+    int srcRelId = OpenRelTable::pinRel(srcRel);
     if (srcRelId == E_RELNOTOPEN) {
         return E_RELNOTOPEN;
     }
@@ -130,14 +169,33 @@ int Algebra::select(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], char attr
     RelCacheTable::resetSearchIndex(srcRelId);
     AttrCacheTable::resetSearchIndex(srcRelId, attr); 
 
+    // choose the access path once for the query, report it and have BlockAccess::search() take it
+    int indexCost, linearCost;
+    int accessPath = BlockAccess::chooseAccessPath(srcRelId, attr, attrVal, op, &indexCost, &linearCost);
+    if (accessPath == INDEX_SCAN) {
+        std::cout << "Access path: index scan on " << srcRel << "." << attr
+                  << " (cost " << indexCost << " vs " << linearCost << " blocks for a linear scan)" << std::endl;
+    } else if (indexCost != -1) {
+        std::cout << "Access path: linear scan of " << srcRel
+                  << " (cost " << linearCost << " vs " << indexCost << " blocks for an index scan)" << std::endl;
+    } else {
+        std::cout << "Access path: linear scan of " << srcRel << std::endl;
+    }
+
     // read every record that satisfies the condition by repeatedly calling
     // BlockAccess::search() until there are no more records to be read
+    // or `limit` records have been inserted (the records are queued in `batch` and
+    // appended to the target relation BULK_INSERT_BATCH at a time)
+    int count = 0;
+    InsertBatch batch(targetRelId, src_nAttrs);
 
     /* BlockAccess::search() returns success */
-    while (BlockAccess::search(srcRelId, record, attr, attrVal, op) == SUCCESS) {
+    while ((limit == NO_LIMIT || count < limit) &&
+           BlockAccess::search(srcRelId, record, attrCatEntry.offset, attrVal, op, accessPath) == SUCCESS) {
+        count++;
 
-        // ret = BlockAccess::insert(targetRelId, record);
-        ret = BlockAccess::insert(targetRelId, record);
+        // ret = batchInsert(batch, record);
+        ret = batchInsert(batch, record);
 
         // if (insert fails) {
         //     close the targetrel(by calling Schema::closeRel(targetrel))
@@ -151,6 +209,14 @@ int Algebra::select(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], char attr
         }
     }
 
+    // append the records still queued in the batch
+    ret = flushBatch(batch);
+    if (ret != SUCCESS) {
+        Schema::closeRel(targetRel);
+        Schema::deleteRel(targetRel);
+        return ret;
+    }
+
     // Close the targetRel by calling closeRel() method of schema layer
     Schema::closeRel(targetRel);
 
@@ -158,24 +224,435 @@ int Algebra::select(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], char attr
     return SUCCESS;
 }
 
+/* A predicate `attr op value` of a multi-predicate select, resolved against the source relation */
+struct SelectCondition {
+    int offset;       // offset of the attribute in the record
+    int type;         // NUMBER or STRING
+    int op;
+    Attribute value;
+    int orGroup;
+};
+
+static bool satisfiesCondition(Attribute record[], const SelectCondition &cond) {
+    int cmpVal = compareAttrs(record[cond.offset], cond.value, cond.type);
+    return (cond.op == NE && cmpVal != 0) ||
+           (cond.op == LT && cmpVal < 0) ||
+           (cond.op == LE && cmpVal <= 0) ||
+           (cond.op == EQ && cmpVal == 0) ||
+           (cond.op == GT && cmpVal > 0) ||
+           (cond.op == GE && cmpVal >= 0);
+}
+
+/* the conditions of an OR group are ANDed; the groups are ORed */
+static bool satisfiesConditions(Attribute record[], const std::vector<SelectCondition> &conds) {
+    for (size_t i = 0; i < conds.size();) {
+        bool groupSatisfied = true;
+        size_t j = i;
+        for (; j < conds.size() && conds[j].orGroup == conds[i].orGroup; j++) {
+            groupSatisfied = groupSatisfied && satisfiesCondition(record, conds[j]);
+        }
+        if (groupSatisfied) {
+            return true;
+        }
+        i = j;
+    }
+    return false;
+}
+
+static bool recIdLess(const RecId &a, const RecId &b) {
+    return a.block < b.block || (a.block == b.block && a.slot < b.slot);
+}
+
+/* Resolves the predicates `attrs[i] ops[i] strVals[i]` of a WHERE clause against the
+   relation; predicates with the same orGroup[i] are ANDed and the groups are ORed. */
+static int resolveConditions(int relId, int nConds, char attrs[][ATTR_SIZE], int ops[], char strVals[][ATTR_SIZE],
+    int orGroup[], std::vector<SelectCondition> &conds) {
+    conds.resize(nConds);
+    for (int i = 0; i < nConds; i++) {
+        AttrCatEntry attrCatEntry;
+        if (AttrCacheTable::getAttrCatEntry(relId, attrs[i], &attrCatEntry) != SUCCESS) {
+            return E_ATTRNOTEXIST;
+        }
+
+        conds[i].offset = attrCatEntry.offset;
+        conds[i].type = attrCatEntry.attrType;
+        conds[i].op = ops[i];
+        conds[i].orGroup = orGroup[i];
+
+        if (attrCatEntry.attrType == NUMBER) {
+            if (!isNumber(strVals[i])) {
+                return E_ATTRTYPEMISMATCH;
+            }
+            conds[i].value.nVal = atof(strVals[i]);
+        } else {
+            strcpy(conds[i].value.sVal, strVals[i]);
+        }
+    }
+
+    return SUCCESS;
+}
+
+/* Chooses between the B+ trees of the predicates and a linear scan of the relation, and
+   prints the access path. useIndex[i] is set for the predicates whose B+ tree beats a
+   linear scan; a group is as cheap as its cheapest indexed predicate, the remaining ones
+   are checked on fetch. Returns true if the indexes are to be used. */
+static bool chooseIndexes(int relId, char relName[ATTR_SIZE], char attrs[][ATTR_SIZE],
+    const std::vector<SelectCondition> &conds, std::vector<bool> &useIndex) {
+    int nConds = conds.size();
+    useIndex.assign(nConds, false);
+    bool indexScan = true;
+    int indexCost = 0, linearCost = 1;
+
+    for (int i = 0; i < nConds;) {
+        int groupCost = -1;
+        int j = i;
+        for (; j < nConds && conds[j].orGroup == conds[i].orGroup; j++) {
+            int condIndexCost;
+            AttrCacheTable::resetSearchIndex(relId, attrs[j]);
+            if (BlockAccess::chooseAccessPath(relId, attrs[j], conds[j].value, conds[j].op, &condIndexCost,
+                                              &linearCost) == INDEX_SCAN) {
+                useIndex[j] = true;
+                if (groupCost == -1 || condIndexCost < groupCost) {
+                    groupCost = condIndexCost;
+                }
+            }
+        }
+
+        if (groupCost == -1) {
+            // (this group needs a linear scan, and so does the whole condition)
+            indexScan = false;
+        } else {
+            indexCost += groupCost;
+        }
+        i = j;
+    }
+    indexScan = indexScan && indexCost < linearCost;
+
+    if (indexScan) {
+        std::cout << "Access path: index scan on";
+        int lastPrinted = -1;
+        for (int i = 0; i < nConds; i++) {
+            if (useIndex[i]) {
+                if (lastPrinted != -1) {
+                    std::cout << (conds[i].orGroup != conds[lastPrinted].orGroup ? " OR" : " AND");
+                }
+                std::cout << " " << relName << "." << attrs[i];
+                lastPrinted = i;
+            }
+        }
+        std::cout << " (cost " << indexCost << " vs " << linearCost << " blocks for a linear scan)" << std::endl;
+    } else {
+        std::cout << "Access path: linear scan of " << relName << std::endl;
+    }
+
+    return indexScan;
+}
+
+/* Returns the rec-ids found by the B+ trees of the indexed predicates, in rec-id order:
+   the rec-ids of the predicates of a group are intersected and the groups are unioned.
+   The predicates that were not answered by an index still have to be checked. */
+static std::vector<RecId> indexMatches(int relId, const std::vector<SelectCondition> &conds,
+    const std::vector<bool> &useIndex) {
+    int nConds = conds.size();
+
+    // matches[] is the sorted union of the groups seen so far
+    std::vector<RecId> matches;
+
+    for (int i = 0; i < nConds;) {
+        // groupMatches[] is the sorted intersection of the indexed predicates of the group
+        std::vector<RecId> groupMatches;
+        bool first = true;
+
+        int j = i;
+        for (; j < nConds && conds[j].orGroup == conds[i].orGroup; j++) {
+            if (!useIndex[j]) {
+                continue;
+            }
+
+            std::vector<RecId> condMatches;
+            AttrCacheTable::resetSearchIndex(relId, conds[j].offset);
+            while (true) {
+                RecId recId = BPlusTree::bPlusSearch(relId, conds[j].offset, conds[j].value, conds[j].op);
+                if (recId.block == -1 && recId.slot == -1) {
+                    break;
+                }
+                condMatches.push_back(recId);
+            }
+            AttrCacheTable::resetSearchIndex(relId, conds[j].offset);
+            std::sort(condMatches.begin(), condMatches.end(), recIdLess);
+
+            if (first) {
+                groupMatches.swap(condMatches);
+                first = false;
+            } else {
+                std::vector<RecId> intersection;
+                std::set_intersection(groupMatches.begin(), groupMatches.end(), condMatches.begin(),
+                                      condMatches.end(), std::back_inserter(intersection), recIdLess);
+                groupMatches.swap(intersection);
+            }
+        }
+
+        std::vector<RecId> merged;
+        std::set_union(matches.begin(), matches.end(), groupMatches.begin(), groupMatches.end(),
+                       std::back_inserter(merged), recIdLess);
+        matches.swap(merged);
+        i = j;
+    }
+
+    return matches;
+}
+
+/*
+    This function selects the records of the source relation satisfying a condition made of
+    nConds predicates `attrs[i] ops[i] strVals[i]` into a new target relation. Predicates
+    with the same orGroup[i] are ANDed and the groups are ORed (AND binds tighter than OR);
+    the predicates of a group must be adjacent.
+
+    If every group has a predicate that is cheaper to answer with its B+ tree than with a
+    linear scan, the rec-ids matching the indexed predicates of a group are intersected,
+    the groups are unioned, and only the resulting records are fetched, in block order.
+    Otherwise the relation is scanned once, testing the whole condition on each record.
+*/
+int Algebra::select(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int nConds, char attrs[][ATTR_SIZE], int ops[],
+    char strVals[][ATTR_SIZE], int orGroup[], int limit) {
+    int srcRelId = OpenRelTable::pinRel(srcRel);
+    if (srcRelId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    /*** Resolve the predicates against the source relation ***/
+    std::vector<SelectCondition> conds;
+    int ret = resolveConditions(srcRelId, nConds, attrs, ops, strVals, orGroup, conds);
+    if (ret != SUCCESS) {
+        return ret;
+    }
+
+    /*** Creating and opening the target relation (with the attributes of srcRel) ***/
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(srcRelId, &relCatEntry);
+    int src_nAttrs = relCatEntry.numAttrs;
+
+    char attr_names[src_nAttrs][ATTR_SIZE];
+    int attr_types[src_nAttrs];
+    for (int i = 0; i < src_nAttrs; i++) {
+        AttrCatEntry attrCatEntry;
+        AttrCacheTable::getAttrCatEntry(srcRelId, i, &attrCatEntry);
+        strcpy(attr_names[i], attrCatEntry.attrName);
+        attr_types[i] = attrCatEntry.attrType;
+    }
+
+    ret = Schema::createRel(targetRel, src_nAttrs, attr_names, attr_types);
+    if (ret != SUCCESS) {
+        return ret;
+    }
+
+    int targetRelId = OpenRelTable::openRel(targetRel);
+    if (targetRelId < 0) {
+        Schema::deleteRel(targetRel);
+        return targetRelId;
+    }
+
+    /*** Choose between the indexes and a linear scan ***/
+    std::vector<bool> useIndex;
+    bool indexScan = chooseIndexes(srcRelId, srcRel, attrs, conds, useIndex);
+
+    /*** Selecting and inserting records into the target relation ***/
+    Attribute record[src_nAttrs];
+    int count = 0;
+    InsertBatch batch(targetRelId, src_nAttrs);
+
+    if (indexScan) {
+        std::vector<RecId> matches = indexMatches(srcRelId, conds, useIndex);
+
+        // fetch the candidates block by block, checking the predicates that were not
+        // answered by an index
+        for (size_t i = 0; i < matches.size() && (limit == NO_LIMIT || count < limit); i++) {
+            RecBuffer recBlk(matches[i].block);
+            recBlk.getRecord(record, matches[i].slot);
+            if (!satisfiesConditions(record, conds)) {
+                continue;
+            }
+
+            count++;
+            ret = batchInsert(batch, record);
+            if (ret != SUCCESS) {
+                Schema::closeRel(targetRel);
+                Schema::deleteRel(targetRel);
+                return ret;
+            }
+        }
+    } else {
+        RelCacheTable::resetSearchIndex(srcRelId);
+        while ((limit == NO_LIMIT || count < limit) && BlockAccess::project(srcRelId, record) == SUCCESS) {
+            if (!satisfiesConditions(record, conds)) {
+                continue;
+            }
+
+            count++;
+            ret = batchInsert(batch, record);
+            if (ret != SUCCESS) {
+                Schema::closeRel(targetRel);
+                Schema::deleteRel(targetRel);
+                return ret;
+            }
+        }
+    }
+
+    // append the records still queued in the batch
+    ret = flushBatch(batch);
+    if (ret != SUCCESS) {
+        Schema::closeRel(targetRel);
+        Schema::deleteRel(targetRel);
+        return ret;
+    }
+
+    Schema::closeRel(targetRel);
+
+    return SUCCESS;
+}
+
+/*
+    Collects the rec-ids of the records of the relation satisfying the resolved conditions
+    (every record if there are none), through the B+ trees of the predicates if that is
+    cheaper than a linear scan.
+*/
+static std::vector<RecId> findMatches(int relId, char relName[ATTR_SIZE], char attrs[][ATTR_SIZE],
+                                      const std::vector<SelectCondition> &conds) {
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+    Attribute record[relCatEntry.numAttrs];
+
+    std::vector<RecId> matches;
+    std::vector<bool> useIndex;
+    if (!conds.empty() && chooseIndexes(relId, relName, attrs, conds, useIndex)) {
+        for (RecId recId : indexMatches(relId, conds, useIndex)) {
+            RecBuffer recBlk(recId.block);
+            recBlk.getRecord(record, recId.slot);
+            if (satisfiesConditions(record, conds)) {
+                matches.push_back(recId);
+            }
+        }
+    } else {
+        RelCacheTable::resetSearchIndex(relId);
+        while (BlockAccess::project(relId, record) == SUCCESS) {
+            if (conds.empty() || satisfiesConditions(record, conds)) {
+                // (the search index is at the record returned by project())
+                RecId recId;
+                RelCacheTable::getSearchIndex(relId, &recId);
+                matches.push_back(recId);
+            }
+        }
+        RelCacheTable::resetSearchIndex(relId);
+    }
+
+    return matches;
+}
+
+/*
+    This function deletes the records of the relation satisfying a condition made of nConds
+    predicates, combined as in the AND/OR select(); with no predicates every record is
+    deleted. The rec-ids of the matching records are collected first, through the B+ trees
+    of the predicates if that is cheaper than a linear scan, and the records are then
+    deleted together by BlockAccess::deleteRecords().
+*/
+int Algebra::deleteRecords(char relName[ATTR_SIZE], int nConds, char attrs[][ATTR_SIZE], int ops[],
+    char strVals[][ATTR_SIZE], int orGroup[], int *numDeleted) {
+    *numDeleted = 0;
+
+    if (strcmp(relName, RELCAT_RELNAME) == 0 || strcmp(relName, ATTRCAT_RELNAME) == 0 ||
+        strcmp(relName, STATCAT_RELNAME) == 0) {
+        return E_NOTPERMITTED;
+    }
+
+    int relId = OpenRelTable::pinRel(relName);
+    if (relId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    std::vector<SelectCondition> conds;
+    int ret = resolveConditions(relId, nConds, attrs, ops, strVals, orGroup, conds);
+    if (ret != SUCCESS) {
+        return ret;
+    }
+
+    std::vector<RecId> matches = findMatches(relId, relName, attrs, conds);
+
+    *numDeleted = matches.size();
+    return BlockAccess::deleteRecords(relId, matches.data(), matches.size());
+}
+
+/*
+    This function sets the attributes setAttrs[0..nSet-1] to the values setVals[] in the
+    records of the relation satisfying a condition made of nConds predicates, combined as in
+    the AND/OR select(); with no predicates every record is updated. The records are
+    rewritten in place by BlockAccess::updateRecords(), which only touches the B+ trees of
+    the attributes being set.
+*/
+int Algebra::update(char relName[ATTR_SIZE], int nSet, char setAttrs[][ATTR_SIZE], char setVals[][ATTR_SIZE],
+    int nConds, char attrs[][ATTR_SIZE], int ops[], char strVals[][ATTR_SIZE], int orGroup[], int *numUpdated) {
+    *numUpdated = 0;
+
+    if (strcmp(relName, RELCAT_RELNAME) == 0 || strcmp(relName, ATTRCAT_RELNAME) == 0 ||
+        strcmp(relName, STATCAT_RELNAME) == 0) {
+        return E_NOTPERMITTED;
+    }
+
+    int relId = OpenRelTable::pinRel(relName);
+    if (relId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    // the offsets and the values of the attributes being set
+    int attrOffsets[nSet];
+    Attribute values[nSet];
+    for (int i = 0; i < nSet; i++) {
+        AttrCatEntry attrCatEntry;
+        if (AttrCacheTable::getAttrCatEntry(relId, setAttrs[i], &attrCatEntry) == E_ATTRNOTEXIST) {
+            return E_ATTRNOTEXIST;
+        }
+
+        attrOffsets[i] = attrCatEntry.offset;
+        if (attrCatEntry.attrType == NUMBER) {
+            if (!isNumber(setVals[i])) {
+                return E_ATTRTYPEMISMATCH;
+            }
+            values[i].nVal = atof(setVals[i]);
+        } else {
+            strcpy(values[i].sVal, setVals[i]);
+        }
+    }
+
+    std::vector<SelectCondition> conds;
+    int ret = resolveConditions(relId, nConds, attrs, ops, strVals, orGroup, conds);
+    if (ret != SUCCESS) {
+        return ret;
+    }
+
+    std::vector<RecId> matches = findMatches(relId, relName, attrs, conds);
+
+    *numUpdated = matches.size();
+    return BlockAccess::updateRecords(relId, matches.data(), matches.size(), attrOffsets, values, nSet);
+}
+
 /* This method inserts the given record into the specified Relation. Insertion
   is only done if the Relation is open and attribute number and types match.
  */
 int Algebra::insert(char relName[ATTR_SIZE], int nAttrs, char record[][ATTR_SIZE]) {
-	// if relName is equal to "RELATIONCAT" or "ATTRIBUTECAT"
+	// if relName is equal to "RELATIONCAT", "ATTRIBUTECAT" or "STATISTICSCAT"
 	// return E_NOTPERMITTED;
 	if (
 		strcmp(relName, RELCAT_RELNAME) == 0 ||
-		strcmp(relName, ATTRCAT_RELNAME) == 0
+		strcmp(relName, ATTRCAT_RELNAME) == 0 ||
+		strcmp(relName, STATCAT_RELNAME) == 0
 		) {
 		return E_NOTPERMITTED;
 	}
 
-	// get the relation's rel-id using OpenRelTable::getRelId() method
-	int relId = OpenRelTable::getRelId(relName);
+	// get the relation's rel-id using OpenRelTable::pinRel() method
+	int relId = OpenRelTable::pinRel(relName);
 
 	// if relation is not open in open relation table, return E_RELNOTOPEN
-	// (check if the value returned from getRelId function call = E_RELNOTOPEN)
+	// (check if the value returned from pinRel function call = E_RELNOTOPEN)
 	// get the relation catalog entry from relation cache
 	// (use RelCacheTable::getRelCatEntry() of Cache Layer)
 	if (relId == E_RELNOTOPEN) {
@@ -237,14 +714,225 @@ int Algebra::insert(char relName[ATTR_SIZE], int nAttrs, char record[][ATTR_SIZE
 	return retVal;
 }
 
+/* Lines of a csv file parsed by one thread of Algebra::insertFromFile() */
+struct CsvChunk {
+    const char *begin, *end;          // [begin, end) holds whole lines of the file
+    std::vector<Attribute> records;   // records of the lines parsed successfully
+    int numLines = 0;                 // number of lines parsed successfully
+    int error = SUCCESS;              // error in line numLines + 1 of the chunk, if any
+};
+
+/* Parses a NUMBER field the way isNumber() and atof() do for a single insert (including
+   the truncation of the value to ATTR_SIZE - 1 characters), using std::from_chars. */
+static bool parseNumber(const char *begin, const char *end, double *val) {
+    end = std::min(end, begin + ATTR_SIZE - 1);
+    while (begin < end && isspace((unsigned char)*begin)) {
+        begin++;
+    }
+    while (end > begin && isspace((unsigned char)end[-1])) {
+        end--;
+    }
+    if (end - begin > 1 && begin[0] == '+' && begin[1] != '-') {
+        begin++;
+    }
+
+    std::from_chars_result result = std::from_chars(begin, end, *val);
+    return result.ec == std::errc() && result.ptr == end && begin < end;
+}
+
+/* Converts the lines of the chunk to records of a relation with the given attribute types,
+   stopping at the first line that is not a valid record. */
+static void parseCsvChunk(CsvChunk *chunk, int numAttrs, const int *attrTypes) {
+    const char *line = chunk->begin;
+    while (line < chunk->end) {
+        const char *lineEnd = (const char *)memchr(line, '\n', chunk->end - line);
+        const char *nextLine = lineEnd ? lineEnd + 1 : chunk->end;
+        if (lineEnd == nullptr) {
+            lineEnd = chunk->end;
+        }
+        if (lineEnd > line && lineEnd[-1] == '\r') {
+            lineEnd--;
+        }
+
+        size_t base = chunk->records.size();
+        chunk->records.resize(base + numAttrs);
+        Attribute *record = &chunk->records[base];
+
+        int error = SUCCESS, attr = 0;
+        const char *field = line;
+        while (true) {
+            const char *fieldEnd = (const char *)memchr(field, ',', lineEnd - field);
+            if (fieldEnd == nullptr) {
+                fieldEnd = lineEnd;
+            }
+
+            if (attr == numAttrs) {
+                error = E_NATTRMISMATCH;
+                break;
+            }
+            if (fieldEnd == field) {
+                error = E_NULLVALUE;
+                break;
+            }
+
+            if (attrTypes[attr] == NUMBER) {
+                if (!parseNumber(field, fieldEnd, &record[attr].nVal)) {
+                    error = E_ATTRTYPEMISMATCH;
+                    break;
+                }
+            } else {
+                size_t len = std::min<size_t>(fieldEnd - field, ATTR_SIZE - 1);
+                memcpy(record[attr].sVal, field, len);
+            }
+            attr++;
+
+            if (fieldEnd == lineEnd) {
+                break;
+            }
+            field = fieldEnd + 1;
+        }
+        if (error == SUCCESS && attr != numAttrs) {
+            error = E_NATTRMISMATCH;
+        }
+
+        if (error != SUCCESS) {
+            chunk->records.resize(base);
+            chunk->error = error;
+            return;
+        }
+
+        chunk->numLines++;
+        line = nextLine;
+    }
+}
+
+/*
+    This function inserts the records of a csv file (one record per line, values separated
+    by commas) into the relation. The file is memory-mapped and split into chunks of whole
+    lines that are parsed by parallel threads; the records are then appended to the relation
+    with BlockAccess::bulkInsert(), which updates the indexes once at the end.
+
+    Records are inserted up to the first invalid line of the file. The number of records
+    inserted is stored in numInserted and the error of the invalid line (if any) is returned.
+*/
+int Algebra::insertFromFile(char relName[ATTR_SIZE], const char *filePath, int *numInserted) {
+    *numInserted = 0;
+
+    if (
+        strcmp(relName, RELCAT_RELNAME) == 0 ||
+        strcmp(relName, ATTRCAT_RELNAME) == 0 ||
+        strcmp(relName, STATCAT_RELNAME) == 0
+        ) {
+        return E_NOTPERMITTED;
+    }
+
+    int relId = OpenRelTable::pinRel(relName);
+    if (relId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+    int numAttrs = relCatEntry.numAttrs;
+
+    std::vector<int> attrTypes(numAttrs);
+    for (int i = 0; i < numAttrs; i++) {
+        AttrCatEntry attrCatEntry;
+        AttrCacheTable::getAttrCatEntry(relId, i, &attrCatEntry);
+        attrTypes[i] = attrCatEntry.attrType;
+    }
+
+    // map the file into memory
+    int fd = open(filePath, O_RDONLY);
+    if (fd < 0) {
+        return E_FILENOTEXIST;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode)) {
+        close(fd);
+        return E_FILENOTEXIST;
+    }
+
+    size_t size = fileStat.st_size;
+    if (size == 0) {
+        close(fd);
+        return SUCCESS;
+    }
+
+    void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return FAILURE;
+    }
+    madvise(map, size, MADV_SEQUENTIAL);
+    const char *data = (const char *)map;
+
+    // split the file into one chunk of whole lines per thread (at least CSV_CHUNK_MIN bytes each)
+    size_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+    numThreads = std::min(numThreads, size / CSV_CHUNK_MIN + 1);
+
+    std::vector<CsvChunk> chunks(numThreads);
+    const char *begin = data;
+    size_t numChunks = 0;
+    while (numChunks < numThreads && begin < data + size) {
+        const char *end = data + size * (numChunks + 1) / numThreads;
+        if (end < begin) {
+            end = begin;
+        }
+        const char *newline = (const char *)memchr(end, '\n', data + size - end);
+        end = newline ? newline + 1 : data + size;
+
+        chunks[numChunks].begin = begin;
+        chunks[numChunks].end = end;
+        numChunks++;
+        begin = end;
+    }
+    chunks.resize(numChunks);
+
+    // parse the chunks in parallel (the first one on this thread)
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < numChunks; i++) {
+        threads.emplace_back(parseCsvChunk, &chunks[i], numAttrs, attrTypes.data());
+    }
+    parseCsvChunk(&chunks[0], numAttrs, attrTypes.data());
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    // gather the records up to the first invalid line
+    int numLines = 0, error = SUCCESS;
+    std::vector<Attribute> records;
+    for (CsvChunk &chunk : chunks) {
+        if (records.empty()) {
+            records.swap(chunk.records);
+        } else {
+            records.insert(records.end(), chunk.records.begin(), chunk.records.end());
+        }
+        numLines += chunk.numLines;
+        if (chunk.error != SUCCESS) {
+            error = chunk.error;
+            break;
+        }
+    }
+    munmap(map, size);
+
+    int ret = BlockAccess::bulkInsert(relId, records.data(), numLines, numInserted);
+
+    // an invalid line is reported over the warning about dropped indexes
+    if (ret == SUCCESS || (ret == E_INDEX_BLOCKS_RELEASED && error != SUCCESS)) {
+        return error;
+    }
+    return ret;
+}
+
 /* 
     This function creates a `copy` of the `source` relation in the `target` relation. 
     Every record of the source relation is inserted into the target relation. 
 */
-int Algebra::project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE]) {
+int Algebra::project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int limit) {
 
-    /*srcRel's rel-id (use OpenRelTable::getRelId() function)*/
-    int srcRelId = OpenRelTable::getRelId(srcRel);
+    /*srcRel's rel-id (use OpenRelTable::pinRel() function)*/
+    int srcRelId = OpenRelTable::pinRel(srcRel);
 
     // if srcRel is not open in open relation table, return E_RELNOTOPEN
     if (srcRelId == E_RELNOTOPEN) {
@@ -305,14 +993,18 @@ int Algebra::project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE]) {
     Attribute record[numAttrs];
 
     RelCacheTable::resetSearchIndex(srcRelId);
-    
+
+    int count = 0;
+    InsertBatch batch(targetRelId, numAttrs);
+
     /* while BlockAccess::project(srcRelId, record) returns SUCCESS */
-    while (BlockAccess::project(srcRelId, record) == SUCCESS)
+    while ((limit == NO_LIMIT || count < limit) && BlockAccess::project(srcRelId, record) == SUCCESS)
     {
         // record will contain the next record
+        count++;
 
-        // ret = BlockAccess::insert(targetRelId, proj_record);
-        ret = BlockAccess::insert(targetRelId, record);
+        // ret = batchInsert(batch, record);
+        ret = batchInsert(batch, record);
 
         /* if insert fails */
         if (ret != SUCCESS) {
@@ -325,6 +1017,14 @@ int Algebra::project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE]) {
         }
     }
 
+    // append the records still queued in the batch
+    ret = flushBatch(batch);
+    if (ret != SUCCESS) {
+        Schema::closeRel(targetRel);
+        Schema::deleteRel(targetRel);
+        return ret;
+    }
+
     // Close the targetRel by calling Schema::closeRel()
     Schema::closeRel(targetRel);
 
@@ -337,10 +1037,11 @@ int Algebra::project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE]) {
 in the arguments. For each record of the source relation, it inserts a new record 
 into the target relation with the attribute values corresponding to the attributes 
 specified in the attribute list. */
-int Algebra::project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int tar_nAttrs, char tar_Attrs[][ATTR_SIZE]) {
+int Algebra::project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int tar_nAttrs, char tar_Attrs[][ATTR_SIZE],
+    int limit) {
 
-    /*srcRel's rel-id (use OpenRelTable::getRelId() function)*/
-    int srcRelId = OpenRelTable::getRelId(srcRel);
+    /*srcRel's rel-id (use OpenRelTable::pinRel() function)*/
+    int srcRelId = OpenRelTable::pinRel(srcRel);
 
     // if srcRel is not open in open relation table, return E_RELNOTOPEN
     if (srcRelId == E_RELNOTOPEN) {
@@ -412,10 +1113,13 @@ int Algebra::project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int tar_
     RelCacheTable::resetSearchIndex(srcRelId);
 
     Attribute record[src_nAttrs];
+    int count = 0;
+    InsertBatch batch(targetRelId, tar_nAttrs);
 
     /* while BlockAccess::project(srcRelId, record) returns SUCCESS */
-    while (BlockAccess::project(srcRelId, record) == SUCCESS) {
+    while ((limit == NO_LIMIT || count < limit) && BlockAccess::project(srcRelId, record) == SUCCESS) {
         // the variable `record` will contain the next record
+        count++;
 
         Attribute proj_record[tar_nAttrs];
 
@@ -425,8 +1129,8 @@ int Algebra::project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int tar_
             proj_record[i] = record[attr_offset[i]];
         }
 
-        // ret = BlockAccess::insert(targetRelId, proj_record);
-        ret = BlockAccess::insert(targetRelId, proj_record);
+        // ret = batchInsert(batch, proj_record);
+        ret = batchInsert(batch, proj_record);
 
         /*if insert fails */
         if (ret != SUCCESS) {
@@ -439,6 +1143,14 @@ int Algebra::project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int tar_
         }
     }
 
+    // append the records still queued in the batch
+    ret = flushBatch(batch);
+    if (ret != SUCCESS) {
+        Schema::closeRel(targetRel);
+        Schema::deleteRel(targetRel);
+        return ret;
+    }
+
     // Close the targetRel by calling Schema::closeRel()
     Schema::closeRel(targetRel);
 
@@ -447,14 +1159,16 @@ int Algebra::project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int tar_
 }
 
 /* creates a new target relation with attributes constituting from both the source 
-relations (excluding the specified join-attribute from the second source relation). */
-int Algebra::join(char srcRelation1[ATTR_SIZE], char srcRelation2[ATTR_SIZE], char targetRelation[ATTR_SIZE], char attribute1[ATTR_SIZE], char attribute2[ATTR_SIZE]) {
+relations (excluding the specified join-attribute from the second source relation). 
+Both scans stop as soon as `limit` joined records have been produced. */
+int Algebra::join(char srcRelation1[ATTR_SIZE], char srcRelation2[ATTR_SIZE], char targetRelation[ATTR_SIZE], char attribute1[ATTR_SIZE], char attribute2[ATTR_SIZE],
+    int limit) {
 
-    // get the srcRelation1's rel-id using OpenRelTable::getRelId() method
-    int srcRelId1 = OpenRelTable::getRelId(srcRelation1),
+    // get the srcRelation1's rel-id using OpenRelTable::pinRel() method
+    int srcRelId1 = OpenRelTable::pinRel(srcRelation1),
 
-    // get the srcRelation2's rel-id using OpenRelTable::getRelId() method
-    srcRelId2 = OpenRelTable::getRelId(srcRelation2);
+    // get the srcRelation2's rel-id using OpenRelTable::pinRel() method
+    srcRelId2 = OpenRelTable::pinRel(srcRelation2);
 
     // if either of the two source relations is not open
     //     return E_RELNOTOPEN
@@ -582,8 +1296,15 @@ int Algebra::join(char srcRelation1[ATTR_SIZE], char srcRelation2[ATTR_SIZE], ch
     // reset search index of srcRelation1 in the relation cache
     RelCacheTable::resetSearchIndex(srcRelId1);
 
+    // srcRelation2 is probed through the index on attribute2 (built above if it was missing);
+    // the path is decided here once, not per record of srcRelation1
+    int accessPath = INDEX_SCAN;
+
+    int count = 0;
+    InsertBatch batch(targetRelId, numOfAttributesInTarget);
+
     // this loop is to get every record of the srcRelation1 one by one
-    while (BlockAccess::project(srcRelId1, record1) == SUCCESS) {
+    while ((limit == NO_LIMIT || count < limit) && BlockAccess::project(srcRelId1, record1) == SUCCESS) {
 
         // reset the search index of `srcRelation2` in the relation cache
         // using RelCacheTable::resetSearchIndex()
@@ -591,14 +1312,15 @@ int Algebra::join(char srcRelation1[ATTR_SIZE], char srcRelation2[ATTR_SIZE], ch
 
         // reset the search index of `attribute2` in the attribute cache
         // using AttrCacheTable::resetSearchIndex()
-        AttrCacheTable::resetSearchIndex(srcRelId2, attribute2);
+        AttrCacheTable::resetSearchIndex(srcRelId2, attrCatEntry2.offset);
 
         // this loop is to get every record of the srcRelation2 which satisfies
         //the following condition:
         // record1.attribute1 = record2.attribute2 (i.e. Equi-Join condition)
-        while (BlockAccess::search(
-            srcRelId2, record2, attribute2, record1[attrCatEntry1.offset], EQ
+        while ((limit == NO_LIMIT || count < limit) && BlockAccess::search(
+            srcRelId2, record2, attrCatEntry2.offset, record1[attrCatEntry1.offset], EQ, accessPath
         ) == SUCCESS ) {
+            count++;
 
             // copy srcRelation1's and srcRelation2's attribute values(except
             // for attribute2 in rel2) from record1 and record2 to targetRecord
@@ -614,9 +1336,9 @@ int Algebra::join(char srcRelation1[ATTR_SIZE], char srcRelation2[ATTR_SIZE], ch
                 }
             }
 
-            // insert the current record into the target relation by calling
-            // BlockAccess::insert()
-            ret = BlockAccess::insert(targetRelId, targetRecord);
+            // queue the current record for insertion into the target relation
+            // by calling batchInsert()
+            ret = batchInsert(batch, targetRecord);
 
             /* if insert fails (insert should fail only due to DISK being FULL) */
             if(ret != SUCCESS) {
@@ -630,6 +1352,187 @@ int Algebra::join(char srcRelation1[ATTR_SIZE], char srcRelation2[ATTR_SIZE], ch
         }
     }
 
+    // append the records still queued in the batch
+    ret = flushBatch(batch);
+    if (ret != SUCCESS) {
+        OpenRelTable::closeRel(targetRelId);
+        Schema::deleteRel(targetRelation);
+        return E_DISKFULL;
+    }
+
     // close the target relation by calling OpenRelTable::closeRel()
     return SUCCESS;
-}
\ No newline at end of file
+}
+/* A record held in memory by sort(), tagged with its position in the scan so that
+   records with equal sort keys keep their original relative order. */
+struct SortRecord {
+    std::vector<Attribute> values;
+    int seq;
+};
+
+/* This function creates a new target relation with the attributes of the source relation
+   and inserts its records ordered by `attr`. With a limit, only the first `limit` records
+   of that order are kept, in a bounded heap, instead of sorting the whole relation. */
+int Algebra::sort(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], char attr[ATTR_SIZE], bool descending,
+    int limit) {
+    // get the srcRel's rel-id using OpenRelTable::pinRel()
+    // if srcRel is not open in open relation table, return E_RELNOTOPEN
+    int srcRelId = OpenRelTable::pinRel(srcRel);
+    if (srcRelId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    // get the attr-cat entry for attr, using AttrCacheTable::getAttrCatEntry()
+    AttrCatEntry sortAttrCatEntry;
+    int ret = AttrCacheTable::getAttrCatEntry(srcRelId, attr, &sortAttrCatEntry);
+    if (ret != SUCCESS) {
+        return ret;
+    }
+
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(srcRelId, &relCatEntry);
+    int src_nAttrs = relCatEntry.numAttrs;
+
+    char attr_names[src_nAttrs][ATTR_SIZE];
+    int attr_types[src_nAttrs];
+    for (int i = 0; i < src_nAttrs; i++) {
+        AttrCatEntry attrCatEntry;
+        AttrCacheTable::getAttrCatEntry(srcRelId, i, &attrCatEntry);
+        strcpy(attr_names[i], attrCatEntry.attrName);
+        attr_types[i] = attrCatEntry.attrType;
+    }
+
+    int offset = sortAttrCatEntry.offset;
+    int type = sortAttrCatEntry.attrType;
+
+    // `precedes(a, b)` is true if record a comes before record b in the output
+    auto precedes = [offset, type, descending](const SortRecord &a, const SortRecord &b) {
+        int cmpVal = compareAttrs(a.values[offset], b.values[offset], type);
+        if (cmpVal != 0) {
+            return descending ? cmpVal > 0 : cmpVal < 0;
+        }
+        return a.seq < b.seq;
+    };
+
+    /*** Reading the records of the source relation ***/
+    // with a limit, `heap` is a max-heap (by output order) of the best `limit`
+    // records seen so far; its top is the record to drop next
+    std::priority_queue<SortRecord, std::vector<SortRecord>, decltype(precedes)> heap(precedes);
+    std::vector<SortRecord> records;
+
+    Attribute record[src_nAttrs];
+    RelCacheTable::resetSearchIndex(srcRelId);
+
+    for (int seq = 0; limit != 0 && BlockAccess::project(srcRelId, record) == SUCCESS; seq++) {
+        SortRecord sortRecord{std::vector<Attribute>(record, record + src_nAttrs), seq};
+
+        if (limit == NO_LIMIT) {
+            records.push_back(std::move(sortRecord));
+        } else if ((int)heap.size() < limit) {
+            heap.push(std::move(sortRecord));
+        } else if (precedes(sortRecord, heap.top())) {
+            heap.pop();
+            heap.push(std::move(sortRecord));
+        }
+    }
+
+    if (limit == NO_LIMIT) {
+        std::sort(records.begin(), records.end(), precedes);
+    } else {
+        // the heap pops records last-first; fill `records` from the back
+        records.resize(heap.size());
+        for (int i = records.size() - 1; i >= 0; i--) {
+            records[i] = heap.top();
+            heap.pop();
+        }
+    }
+
+    /*** Creating and opening the target relation ***/
+    ret = Schema::createRel(targetRel, src_nAttrs, attr_names, attr_types);
+    if (ret != SUCCESS) {
+        return ret;
+    }
+
+    int targetRelId = OpenRelTable::openRel(targetRel);
+    if (targetRelId < 0) {
+        Schema::deleteRel(targetRel);
+        return targetRelId;
+    }
+
+    /*** Inserting the records into the target relation in order ***/
+    InsertBatch batch(targetRelId, src_nAttrs);
+    for (SortRecord &sortRecord : records) {
+        ret = batchInsert(batch, sortRecord.values.data());
+        if (ret != SUCCESS) {
+            Schema::closeRel(targetRel);
+            Schema::deleteRel(targetRel);
+            return ret;
+        }
+    }
+
+    // append the records still queued in the batch
+    ret = flushBatch(batch);
+    if (ret != SUCCESS) {
+        Schema::closeRel(targetRel);
+        Schema::deleteRel(targetRel);
+        return ret;
+    }
+
+    // Close the targetRel by calling Schema::closeRel()
+    Schema::closeRel(targetRel);
+
+    return SUCCESS;
+}
+
+/* Computes MIN(attr), MAX(attr) or COUNT(*) over the source relation. COUNT is read from
+   the relation catalog entry and MIN/MAX of an indexed attribute from its B+ tree; only
+   MIN/MAX of an unindexed attribute needs a scan of the records. */
+int Algebra::aggregate(char srcRel[ATTR_SIZE], char attr[ATTR_SIZE], int aggOp, Attribute *result, int *resultType) {
+    // get the srcRel's rel-id using OpenRelTable::pinRel()
+    // if srcRel is not open in open relation table, return E_RELNOTOPEN
+    int srcRelId = OpenRelTable::pinRel(srcRel);
+    if (srcRelId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(srcRelId, &relCatEntry);
+
+    // COUNT(*) is the number of records kept in the relation catalog entry
+    if (aggOp == AGG_COUNT) {
+        result->nVal = relCatEntry.numRecs;
+        *resultType = NUMBER;
+        return SUCCESS;
+    }
+
+    // get the attr-cat entry for attr, using AttrCacheTable::getAttrCatEntry()
+    AttrCatEntry attrCatEntry;
+    int ret = AttrCacheTable::getAttrCatEntry(srcRelId, attr, &attrCatEntry);
+    if (ret != SUCCESS) {
+        return ret;
+    }
+    *resultType = attrCatEntry.attrType;
+
+    // if attr has an index, its first/last leaf entry holds the answer
+    if (attrCatEntry.rootBlock != -1) {
+        return BPlusTree::bPlusMinMax(srcRelId, attr, aggOp, result);
+    }
+
+    /*** No index; scan every record of the relation ***/
+    Attribute record[relCatEntry.numAttrs];
+    bool found = false;
+
+    RelCacheTable::resetSearchIndex(srcRelId);
+
+    while (BlockAccess::project(srcRelId, record) == SUCCESS) {
+        Attribute value = record[attrCatEntry.offset];
+        int cmpVal = found ? compareAttrs(value, *result, attrCatEntry.attrType) : 0;
+
+        if (!found || (aggOp == AGG_MIN && cmpVal < 0) || (aggOp == AGG_MAX && cmpVal > 0)) {
+            *result = value;
+            found = true;
+        }
+    }
+
+    return found ? SUCCESS : E_NOTFOUND;
+}
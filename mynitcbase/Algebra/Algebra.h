@@ -10,18 +10,42 @@ public:
     // Insert
     static int insert(char relName[ATTR_SIZE], int numberOfAttributes, char record[][ATTR_SIZE]);
 
+    // Insert the records of a csv file
+    static int insertFromFile(char relName[ATTR_SIZE], const char *filePath, int *numInserted);
+
     // Select
-    static int select(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], char attr[ATTR_SIZE], int op, char strVal[ATTR_SIZE]);
+    static int select(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], char attr[ATTR_SIZE], int op, char strVal[ATTR_SIZE],
+        int limit = NO_LIMIT);
+
+    // Select with AND/OR of several predicates (predicates with the same orGroup are ANDed)
+    static int select(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int nConds, char attrs[][ATTR_SIZE], int ops[],
+        char strVals[][ATTR_SIZE], int orGroup[], int limit = NO_LIMIT);
+
+    // Delete the records satisfying AND/OR predicates as in select() (every record if nConds is 0)
+    static int deleteRecords(char relName[ATTR_SIZE], int nConds, char attrs[][ATTR_SIZE], int ops[],
+        char strVals[][ATTR_SIZE], int orGroup[], int *numDeleted);
+
+    // Set attributes of the records satisfying AND/OR predicates as in select() (every record if nConds is 0)
+    static int update(char relName[ATTR_SIZE], int nSet, char setAttrs[][ATTR_SIZE], char setVals[][ATTR_SIZE],
+        int nConds, char attrs[][ATTR_SIZE], int ops[], char strVals[][ATTR_SIZE], int orGroup[], int *numUpdated);
 
     // Project all (Copy)
-    static int project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE]);
+    static int project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int limit = NO_LIMIT);
 
     // Project
-    static int project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int tar_nAttrs, char tar_Attrs[][ATTR_SIZE]);
+    static int project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int tar_nAttrs, char tar_Attrs[][ATTR_SIZE],
+        int limit = NO_LIMIT);
 
     // Join
     static int join(char srcRelOne[ATTR_SIZE], char srcRelTwo[ATTR_SIZE], char targetRel[ATTR_SIZE],
-        char attrOne[ATTR_SIZE], char attrTwo[ATTR_SIZE]);
+        char attrOne[ATTR_SIZE], char attrTwo[ATTR_SIZE], int limit = NO_LIMIT);
+
+    // Order By
+    static int sort(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], char attr[ATTR_SIZE], bool descending,
+        int limit = NO_LIMIT);
+
+    // Aggregate (MIN, MAX, COUNT)
+    static int aggregate(char srcRel[ATTR_SIZE], char attr[ATTR_SIZE], int aggOp, Attribute *result, int *resultType);
 };
 
 #endif  // NITCBASE_ALGEBRA_H
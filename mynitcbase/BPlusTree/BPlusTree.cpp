@@ -1,19 +1,33 @@
 #include "BPlusTree.h"
 
+#include <algorithm>
 #include <cstring>
+#include <vector>
 
 RecId BPlusTree::bPlusSearch(int relId, char attrName[ATTR_SIZE], Attribute attrVal, int op) {
-    // declare searchIndex which will be used to store search index for attrName.
+    // resolve attrName to the offset of the attribute once
+    AttrCatEntry attrCatEntry;
+    if (AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry) != SUCCESS) {
+        return RecId{-1, -1};
+    }
+
+    return bPlusSearch(relId, attrCatEntry.offset, attrVal, op);
+}
+
+/* Searches the B+ tree index on the attribute at attrOffset of the relation for the next
+   entry satisfying `op attrVal`, continuing from the attribute's search index */
+RecId BPlusTree::bPlusSearch(int relId, int attrOffset, Attribute attrVal, int op) {
+    // declare searchIndex which will be used to store search index for the attribute.
     IndexId searchIndex;
 
-    /* get the search index corresponding to attribute with name attrName
+    /* get the search index corresponding to the attribute at attrOffset
        using AttrCacheTable::getSearchIndex(). */
-    AttrCacheTable::getSearchIndex(relId, attrName, &searchIndex);
+    AttrCacheTable::getSearchIndex(relId, attrOffset, &searchIndex);
 
     AttrCatEntry attrCatEntry;
     /* load the attribute cache entry into attrCatEntry using
      AttrCacheTable::getAttrCatEntry(). */
-    AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    AttrCacheTable::getAttrCatEntry(relId, attrOffset, &attrCatEntry);
 
     // declare variables block and index which will be used during search
     int block, index;
@@ -26,7 +40,7 @@ RecId BPlusTree::bPlusSearch(int relId, char attrName[ATTR_SIZE], Attribute attr
         block = attrCatEntry.rootBlock;
         index = 0;
 
-        /* if attrName doesn't have a B+ tree (block == -1)*/
+        /* if the attribute doesn't have a B+ tree (block == -1)*/
         if (block == -1) {
             return RecId{-1, -1};
         }
@@ -196,7 +210,7 @@ RecId BPlusTree::bPlusSearch(int relId, char attrName[ATTR_SIZE], Attribute attr
 
                 // set search index to {block, index}
                 searchIndex = IndexId{block, index};
-                AttrCacheTable::setSearchIndex(relId, attrName, &searchIndex);
+                AttrCacheTable::setSearchIndex(relId, attrOffset, &searchIndex);
 
                 // return the recId {leafEntry.block, leafEntry.slot}.
                 return RecId {leafEntry.block, leafEntry.slot};
@@ -213,12 +227,12 @@ RecId BPlusTree::bPlusSearch(int relId, char attrName[ATTR_SIZE], Attribute attr
             ++index;
         }
 
-        /*only for NE operation do we have to check the entire linked list;
-        for all the other op it is guaranteed that the block being searched
-        will have an entry, if it exists, satisying that op. */
-        if (op != NE) {
-            break;
-        }
+        /* the leaf ran out before the search was decided: continue with the next
+        leaf. For NE this walks the entire linked list; for the other ops the
+        first leaf holds the answer unless entries were removed from it by
+        bPlusBulkDelete(), which leaves the keys of the internal blocks as they
+        were (they are still upper bounds of their left children). Leaves are
+        never emptied, so then the next leaf holds the answer. */
 
         // block = next block in the linked list, i.e., the rblock in leafHead.
         // update index to 0.
@@ -230,7 +244,64 @@ RecId BPlusTree::bPlusSearch(int relId, char attrName[ATTR_SIZE], Attribute attr
     return RecId {-1, -1};
 }
 
-/* This method creates a B+ Tree (Indexing) for the input attribute of the specified relation. */
+/* Finds the smallest (AGG_MIN) or the largest (AGG_MAX) value of an indexed attribute
+   by walking down the left or right spine of its B+ tree; no record block is read. */
+int BPlusTree::bPlusMinMax(int relId, char attrName[ATTR_SIZE], int aggOp, Attribute *attrVal) {
+    // get the attribute catalog entry of attrName using AttrCacheTable::getAttrCatEntry()
+    AttrCatEntry attrCatEntry;
+    int retVal = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (retVal != SUCCESS) {
+        return retVal;
+    }
+
+    /* if there is no index on attribute (rootBlock is -1) */
+    int block = attrCatEntry.rootBlock;
+    if (block == -1) {
+        return E_NOINDEX;
+    }
+
+    /* while block is of type IND_INTERNAL */
+    while (StaticBuffer::getStaticBlockType(block) == IND_INTERNAL) {
+        IndInternal internalBlk(block);
+
+        HeadInfo intHead;
+        internalBlk.getHeader(&intHead);
+
+        InternalEntry intEntry;
+
+        // AGG_MIN: the leftmost child is the lChild of the first entry
+        // AGG_MAX: the rightmost child is the rChild of the last entry
+        if (aggOp == AGG_MIN) {
+            internalBlk.getEntry(&intEntry, 0);
+            block = intEntry.lChild;
+        } else {
+            internalBlk.getEntry(&intEntry, intHead.numEntries - 1);
+            block = intEntry.rChild;
+        }
+    }
+
+    // NOTE: `block` now has the block number of the leftmost/rightmost leaf.
+    IndLeaf leafBlk(block);
+
+    HeadInfo leafHead;
+    leafBlk.getHeader(&leafHead);
+
+    // an index over an empty relation is a single leaf with no entries
+    if (leafHead.numEntries == 0) {
+        return E_NOTFOUND;
+    }
+
+    Index leafEntry;
+    leafBlk.getEntry(&leafEntry, aggOp == AGG_MIN ? 0 : leafHead.numEntries - 1);
+
+    *attrVal = leafEntry.attrVal;
+
+    return SUCCESS;
+}
+
+/* This method creates a B+ Tree (Indexing) for the input attribute of the specified relation.
+   The index entries of all the records are collected and sorted, and the tree is built
+   bottom-up from them using buildBottomUp(). */
 int BPlusTree::bPlusCreate(int relId, char attrName[ATTR_SIZE]) {
 
     // if relId is either RELCAT_RELID or ATTRCAT_RELID:
@@ -255,24 +326,6 @@ int BPlusTree::bPlusCreate(int relId, char attrName[ATTR_SIZE]) {
         return SUCCESS;
     }
 
-    /******Creating a new B+ Tree ******/
-
-    // get a free leaf block using constructor 1 to allocate a new block
-    IndLeaf rootBlockBuf;
-
-    // (if the block could not be allocated, the appropriate error code
-    //  will be stored in the blockNum member field of the object)
-
-    // declare rootBlock to store the blockNumber of the new leaf block
-    int rootBlock = rootBlockBuf.getBlockNum();
-
-    // if there is no more disk space for creating an index
-    if (rootBlock == E_DISKFULL) {
-        return E_DISKFULL;
-    }
-    attrCatEntry.rootBlock = rootBlock;
-    AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
-
     RelCatEntry relCatEntry;
 
     // load the relation catalog entry into relCatEntry
@@ -282,8 +335,10 @@ int BPlusTree::bPlusCreate(int relId, char attrName[ATTR_SIZE]) {
     /* first record block of the relation */
     int block = relCatEntry.firstBlk;
 
-    /***** Traverse all the blocks in the relation and insert them one
-           by one into the B+ Tree *****/
+    /***** Traverse all the blocks in the relation and collect the index
+           entries of the records *****/
+    std::vector<Index> entries;
+    entries.reserve(relCatEntry.numRecs);
     while (block != -1) {
 
         // declare a RecBuffer object for `block` (using appropriate constructor)
@@ -306,20 +361,12 @@ int BPlusTree::bPlusCreate(int relId, char attrName[ATTR_SIZE]) {
             // using RecBuffer::getRecord().
             recBlk.getRecord(record, i);
 
-            // declare recId and store the rec-id of this record in it
-            // RecId recId{block, slot};
-            RecId recId{block, i};
-
-            // insert the attribute value corresponding to attrName from the record
-            // into the B+ tree using bPlusInsert.
-            // (note that bPlusInsert will destroy any existing bplus tree if
-            // insert fails i.e when disk is full)
-            retVal = bPlusInsert(relId, attrName, record[attrCatEntry.offset], recId);
-
-            if (retVal == E_DISKFULL) {
-                // (unable to get enough blocks to build the B+ Tree.)
-                return E_DISKFULL;
-            }
+            Index entry;
+            entry.attrVal = record[attrCatEntry.offset];
+            entry.block = block;
+            entry.slot = i;
+            memset(entry.unused, 0, sizeof(entry.unused));
+            entries.push_back(entry);
         }
 
         // get the header of the block using BlockBuffer::getHeader()
@@ -330,13 +377,340 @@ int BPlusTree::bPlusCreate(int relId, char attrName[ATTR_SIZE]) {
         block = head.rblock;
     }
 
+    // sort the entries on the attribute (records with equal values stay in rec-id order)
+    int attrType = attrCatEntry.attrType;
+    std::stable_sort(entries.begin(), entries.end(), [attrType](const Index &a, const Index &b) {
+        return compareAttrs(a.attrVal, b.attrVal, attrType) < 0;
+    });
+
+    int rootBlock = buildBottomUp(entries.data(), entries.size());
+
+    // if there is no more disk space for creating an index
+    if (rootBlock == E_DISKFULL) {
+        return E_DISKFULL;
+    }
+
+    attrCatEntry.rootBlock = rootBlock;
+    AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+
+    return SUCCESS;
+}
+
+/* Builds a B+ tree bottom-up from index entries sorted on the attribute. The entries are
+   spread evenly over as few leaves as possible, and each level of internal blocks is built
+   over the level below it in the same way (the key between two children is the largest
+   key of the left child, as in splitLeaf()) until a level has a single block, the root.
+   Returns the root block, or E_DISKFULL after releasing the blocks of the partial tree. */
+int BPlusTree::buildBottomUp(Index entries[], int numEntries) {
+    std::vector<int> allocated;     // blocks of the tree, released if the disk runs out
+    std::vector<int> level;         // blocks of the level being built
+    std::vector<Attribute> maxKeys; // largest key in the subtree of each block of the level
+    const int maxKeysLeaf = IndLeaf::getMaxKeys();
+    const int maxKeysInternal = IndInternal::getMaxKeys();
+
+    /* leaf level, linked through lblock and rblock */
+    int numLeaves = std::max(1, (numEntries + maxKeysLeaf - 1) / maxKeysLeaf);
+    for (int i = 0, next = 0; i < numLeaves; i++) {
+        int count = numEntries / numLeaves + (i < numEntries % numLeaves ? 1 : 0);
+
+        // each block is placed after the previous one, so the tree is contiguous on the disk
+        IndLeaf leafBlk(AfterBlock{allocated.empty() ? -1 : allocated.back()});
+        int leafBlkNum = leafBlk.getBlockNum();
+        if (leafBlkNum == E_DISKFULL) {
+            for (int blockNum : allocated) {
+                BlockBuffer(blockNum).releaseBlock();
+            }
+            return E_DISKFULL;
+        }
+        allocated.push_back(leafBlkNum);
+
+        HeadInfo head;
+        leafBlk.getHeader(&head);
+        head.lblock = level.empty() ? -1 : level.back();
+        head.numEntries = count;
+        leafBlk.setHeader(&head);
+
+        for (int j = 0; j < count; j++) {
+            leafBlk.setEntry(&entries[next + j], j);
+        }
+
+        if (!level.empty()) {
+            IndLeaf prevBlk(level.back());
+            prevBlk.getHeader(&head);
+            head.rblock = leafBlkNum;
+            prevBlk.setHeader(&head);
+        }
+
+        next += count;
+        level.push_back(leafBlkNum);
+        maxKeys.push_back(count > 0 ? entries[next - 1].attrVal : Attribute());
+    }
+
+    /* internal levels, each block having at most maxKeysInternal + 1 children */
+    while (level.size() > 1) {
+        int numChildren = level.size();
+        int numBlocks = (numChildren + maxKeysInternal) / (maxKeysInternal + 1);
+
+        std::vector<int> upperLevel;
+        std::vector<Attribute> upperMaxKeys;
+        for (int i = 0, next = 0; i < numBlocks; i++) {
+            int count = numChildren / numBlocks + (i < numChildren % numBlocks ? 1 : 0);
+
+            IndInternal intBlk(AfterBlock{allocated.back()});
+            int intBlkNum = intBlk.getBlockNum();
+            if (intBlkNum == E_DISKFULL) {
+                for (int blockNum : allocated) {
+                    BlockBuffer(blockNum).releaseBlock();
+                }
+                return E_DISKFULL;
+            }
+            allocated.push_back(intBlkNum);
+
+            HeadInfo head;
+            intBlk.getHeader(&head);
+            head.numEntries = count - 1;
+            intBlk.setHeader(&head);
+
+            for (int j = 0; j < count - 1; j++) {
+                InternalEntry entry;
+                entry.lChild = level[next + j];
+                entry.attrVal = maxKeys[next + j];
+                entry.rChild = level[next + j + 1];
+                intBlk.setEntry(&entry, j);
+            }
+
+            for (int j = 0; j < count; j++) {
+                BlockBuffer childBlk(level[next + j]);
+                childBlk.getHeader(&head);
+                head.pblock = intBlkNum;
+                childBlk.setHeader(&head);
+            }
+
+            next += count;
+            upperLevel.push_back(intBlkNum);
+            upperMaxKeys.push_back(maxKeys[next - 1]);
+        }
+
+        level.swap(upperLevel);
+        maxKeys.swap(upperMaxKeys);
+    }
+
+    return level[0];
+}
+
+/* Inserts a batch of index entries, sorted on the attribute, into the B+ tree of the
+   attribute. The entries of the leaves (which are linked in key order) are merged with the
+   batch and the tree is rebuilt bottom-up from the merged entries, so each block of the
+   index is written once for the batch. If the disk runs out of blocks, the index is
+   destroyed and E_DISKFULL is returned, as in bPlusInsert(). */
+int BPlusTree::bPlusBulkInsert(int relId, char attrName[ATTR_SIZE], Index entries[], int numEntries) {
+    AttrCatEntry attrCatEntry;
+    int retVal = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (retVal != SUCCESS) {
+        return retVal;
+    }
+
+    int rootBlock = attrCatEntry.rootBlock;
+    if (rootBlock == -1) {
+        return E_NOINDEX;
+    }
+
+    // go down the leftmost children to the first leaf
+    int blockNum = rootBlock;
+    while (StaticBuffer::getStaticBlockType(blockNum) == IND_INTERNAL) {
+        IndInternal intBlk(blockNum);
+        InternalEntry intEntry;
+        intBlk.getEntry(&intEntry, 0);
+        blockNum = intEntry.lChild;
+    }
+
+    // merge the entries of the leaves with the batch
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+
+    std::vector<Index> merged;
+    merged.reserve(std::max(relCatEntry.numRecs, numEntries));
+
+    int next = 0;
+    while (blockNum != -1) {
+        IndLeaf leafBlk(blockNum);
+
+        HeadInfo head;
+        leafBlk.getHeader(&head);
+
+        for (int i = 0; i < head.numEntries; i++) {
+            Index leafEntry;
+            leafBlk.getEntry(&leafEntry, i);
+
+            while (next < numEntries &&
+                   compareAttrs(entries[next].attrVal, leafEntry.attrVal, attrCatEntry.attrType) < 0) {
+                merged.push_back(entries[next++]);
+            }
+            merged.push_back(leafEntry);
+        }
+
+        blockNum = head.rblock;
+    }
+    merged.insert(merged.end(), entries + next, entries + numEntries);
+
+    // replace the tree
+    bPlusDestroy(rootBlock);
+    attrCatEntry.rootBlock = -1;
+    AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+
+    rootBlock = buildBottomUp(merged.data(), merged.size());
+    if (rootBlock == E_DISKFULL) {
+        return E_DISKFULL;
+    }
+
+    attrCatEntry.rootBlock = rootBlock;
+    AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+
+    return SUCCESS;
+}
+
+/* Removes a batch of index entries, sorted on the attribute, from the B+ tree of the
+   attribute at attrOffset; an entry is found by its value and the rec-id of its record.
+   A batch that is small next to the index is removed from the leaves in place. Otherwise,
+   or once a removal would leave a leaf less than half full, the tree is rebuilt
+   bottom-up from the entries of the leaves that remain, as in bPlusBulkInsert(). If the
+   disk runs out of blocks, the index is destroyed and E_DISKFULL is returned. */
+int BPlusTree::bPlusBulkDelete(int relId, int attrOffset, Index entries[], int numEntries) {
+    AttrCatEntry attrCatEntry;
+    int retVal = AttrCacheTable::getAttrCatEntry(relId, attrOffset, &attrCatEntry);
+    if (retVal != SUCCESS) {
+        return retVal;
+    }
+
+    int rootBlock = attrCatEntry.rootBlock;
+    if (rootBlock == -1) {
+        return E_NOINDEX;
+    }
+
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+
+    /* removing entries one by one costs a walk down the tree for each, which is cheaper
+       than rewriting every leaf of the index only if the batch is small next to it */
+    int removed = 0;
+    if ((long long)numEntries * IndLeaf::getMaxKeys() < relCatEntry.numRecs - numEntries) {
+        while (removed < numEntries &&
+               removeFromLeaf(rootBlock, entries[removed], attrCatEntry.attrType) != FAILURE) {
+            removed++;
+        }
+    }
+    if (removed == numEntries) {
+        return SUCCESS;
+    }
+
+    // the rec-ids of the entries still to be removed, in rec-id order
+    std::vector<RecId> deleted;
+    deleted.reserve(numEntries - removed);
+    for (int i = removed; i < numEntries; i++) {
+        deleted.push_back(RecId{entries[i].block, entries[i].slot});
+    }
+    auto recIdLess = [](const RecId &a, const RecId &b) {
+        return a.block < b.block || (a.block == b.block && a.slot < b.slot);
+    };
+    std::sort(deleted.begin(), deleted.end(), recIdLess);
+
+    // go down the leftmost children to the first leaf
+    int blockNum = rootBlock;
+    while (StaticBuffer::getStaticBlockType(blockNum) == IND_INTERNAL) {
+        IndInternal intBlk(blockNum);
+        InternalEntry intEntry;
+        intBlk.getEntry(&intEntry, 0);
+        blockNum = intEntry.lChild;
+    }
+
+    // keep the entries of the leaves that are not in the batch
+    std::vector<Index> remaining;
+    remaining.reserve(std::max(0, relCatEntry.numRecs - numEntries));
+    while (blockNum != -1) {
+        IndLeaf leafBlk(blockNum);
+
+        HeadInfo head;
+        leafBlk.getHeader(&head);
+
+        for (int i = 0; i < head.numEntries; i++) {
+            Index leafEntry;
+            leafBlk.getEntry(&leafEntry, i);
+            if (!std::binary_search(deleted.begin(), deleted.end(), RecId{leafEntry.block, leafEntry.slot},
+                                    recIdLess)) {
+                remaining.push_back(leafEntry);
+            }
+        }
+
+        blockNum = head.rblock;
+    }
+
+    // replace the tree
+    bPlusDestroy(rootBlock);
+    attrCatEntry.rootBlock = -1;
+    AttrCacheTable::setAttrCatEntry(relId, attrOffset, &attrCatEntry);
+
+    rootBlock = buildBottomUp(remaining.data(), remaining.size());
+    if (rootBlock == E_DISKFULL) {
+        return E_DISKFULL;
+    }
+
+    attrCatEntry.rootBlock = rootBlock;
+    AttrCacheTable::setAttrCatEntry(relId, attrOffset, &attrCatEntry);
+
     return SUCCESS;
 }
 
+/* Removes an entry from its leaf in the B+ tree rooted at rootBlock, shifting the entries
+   after it down. Returns E_NOTFOUND if the tree has no such entry, and FAILURE without
+   changing the tree if the removal would leave a leaf that is not the root less than half
+   full (leaves are kept at least half full, as after splitLeaf(); see bPlusBulkDelete()). */
+int BPlusTree::removeFromLeaf(int rootBlock, Index entry, int attrType) {
+    // the first leaf that can hold the value is the one an insertion of it would go to
+    int blockNum = findLeafToInsert(rootBlock, entry.attrVal, attrType);
+
+    while (blockNum != -1) {
+        IndLeaf leafBlk(blockNum);
+
+        HeadInfo head;
+        leafBlk.getHeader(&head);
+
+        for (int i = 0; i < head.numEntries; i++) {
+            Index leafEntry;
+            leafBlk.getEntry(&leafEntry, i);
+
+            int cmpVal = compareAttrs(leafEntry.attrVal, entry.attrVal, attrType);
+            if (cmpVal > 0) {
+                return E_NOTFOUND;
+            }
+            if (cmpVal < 0 || leafEntry.block != entry.block || leafEntry.slot != entry.slot) {
+                continue;
+            }
+
+            if (head.numEntries - 1 < IndLeaf::getMaxKeys() / 2 && blockNum != rootBlock) {
+                return FAILURE;
+            }
+
+            for (int j = i; j < head.numEntries - 1; j++) {
+                leafBlk.getEntry(&leafEntry, j + 1);
+                leafBlk.setEntry(&leafEntry, j);
+            }
+            head.numEntries--;
+            leafBlk.setHeader(&head);
+
+            return SUCCESS;
+        }
+
+        // (entries with the value may continue in the next leaf)
+        blockNum = head.rblock;
+    }
+
+    return E_NOTFOUND;
+}
+
 /* Used to delete a B+ Tree rooted at a particular block passed as input to the method. */
 int BPlusTree::bPlusDestroy(int rootBlockNum) {
-    /* if rootBlockNum lies outside the valid range [0,DISK_BLOCKS-1]*/
-    if (rootBlockNum < 0 || rootBlockNum >= DISK_BLOCKS) {
+    /* if rootBlockNum lies outside the valid range [0,numBlocks-1]*/
+    if (rootBlockNum < 0 || rootBlockNum >= Disk::getSuperBlock().numBlocks) {
         return E_OUTOFBOUND;
     }
 
@@ -385,12 +759,13 @@ int BPlusTree::bPlusDestroy(int rootBlockNum) {
     }
 }
 
-/* Inserts an attribute value and the rec-id of the corresponding record into a B+ tree index on the disk */
-int BPlusTree::bPlusInsert(int relId, char attrName[ATTR_SIZE], Attribute attrVal, RecId recId) {
-    // get the attribute cache entry corresponding to attrName
+/* Inserts an attribute value and the rec-id of the corresponding record into the B+ tree
+   index on the attribute at attrOffset of the relation */
+int BPlusTree::bPlusInsert(int relId, int attrOffset, Attribute attrVal, RecId recId) {
+    // get the attribute cache entry of the attribute at attrOffset
     // using AttrCacheTable::getAttrCatEntry().
     AttrCatEntry attrCatEntry;
-    int retVal = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    int retVal = AttrCacheTable::getAttrCatEntry(relId, attrOffset, &attrCatEntry);
 
     // if getAttrCatEntry() failed
     //     return the error code
@@ -416,12 +791,12 @@ int BPlusTree::bPlusInsert(int relId, char attrName[ATTR_SIZE], Attribute attrVa
     // insertIntoLeaf() function.
     // declare a struct Index with attrVal = attrVal, block = recId.block and
     // slot = recId.slot to pass as argument to the function.
-    // insertIntoLeaf(relId, attrName, leafBlkNum, Index entry)
+    // insertIntoLeaf(relId, attrOffset, leafBlkNum, Index entry)
     // NOTE: the insertIntoLeaf() function will propagate the insertion to the
     //       required internal nodes by calling the required helper functions
     //       like insertIntoInternal() or createNewRoot()
     Index leafEntry{attrVal, recId.block, recId.slot};
-    retVal = insertIntoLeaf(relId, attrName, leafBlkNum, leafEntry);
+    retVal = insertIntoLeaf(relId, attrOffset, leafBlkNum, leafEntry);
 
     /* if insertIntoLeaf() returns E_DISKFULL */
     if (retVal == E_DISKFULL) {
@@ -431,7 +806,7 @@ int BPlusTree::bPlusInsert(int relId, char attrName[ATTR_SIZE], Attribute attrVa
         // update the rootBlock of attribute catalog cache entry to -1 using
         // AttrCacheTable::setAttrCatEntry().
         attrCatEntry.rootBlock = -1;
-        AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+        AttrCacheTable::setAttrCatEntry(relId, attrOffset, &attrCatEntry);
 
         return E_DISKFULL;
     }
@@ -486,11 +861,11 @@ int BPlusTree::findLeafToInsert(int rootBlock, Attribute attrVal, int attrType)
 }
 
 /* Used to insert an index entry into a leaf index block of an existing B+ tree. */
-int BPlusTree::insertIntoLeaf(int relId, char attrName[ATTR_SIZE], int blockNum, Index indexEntry) {
-    // get the attribute cache entry corresponding to attrName
+int BPlusTree::insertIntoLeaf(int relId, int attrOffset, int blockNum, Index indexEntry) {
+    // get the attribute cache entry of the attribute at attrOffset
     // using AttrCacheTable::getAttrCatEntry().
     AttrCatEntry attrCatEntry;
-    AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    AttrCacheTable::getAttrCatEntry(relId, attrOffset, &attrCatEntry);
 
     // declare an IndLeaf instance for the block using appropriate constructor
     IndLeaf indLeafBlk(blockNum);
@@ -535,7 +910,7 @@ int BPlusTree::insertIntoLeaf(int relId, char attrName[ATTR_SIZE], int blockNum,
         indices[i] = indexEntry;
     }
 
-    if (blockHeader.numEntries != MAX_KEYS_LEAF) {
+    if (blockHeader.numEntries != IndLeaf::getMaxKeys()) {
         // (leaf block has not reached max limit)
 
         // increment blockHeader.numEntries and update the header of block
@@ -559,6 +934,7 @@ int BPlusTree::insertIntoLeaf(int relId, char attrName[ATTR_SIZE], int blockNum,
     // E_DISKFULL if there are no more blocks to be allocated.
 
     int newRightBlk = splitLeaf(blockNum, indices);
+    int middleIndex = IndLeaf::getMaxKeys() / 2;
 
     // if splitLeaf() returned E_DISKFULL
     //     return E_DISKFULL
@@ -570,27 +946,27 @@ int BPlusTree::insertIntoLeaf(int relId, char attrName[ATTR_SIZE], int blockNum,
     if (blockHeader.pblock != -1) {  // check pblock in header
         // insert the middle value from `indices` into the parent block using the
         // insertIntoInternal() function. (i.e the last value of the left block)
-        // the middle value will be at index 31 (given by constant MIDDLE_INDEX_LEAF)
+        // the middle value will be at index middleIndex (31 for 2048 byte blocks)
 
-        // create a struct InternalEntry with attrVal = indices[MIDDLE_INDEX_LEAF].attrVal,
+        // create a struct InternalEntry with attrVal = indices[middleIndex].attrVal,
         // lChild = currentBlock, rChild = newRightBlk and pass it as argument to
         // the insertIntoInternalFunction as follows
         InternalEntry newIntEntry;
-        newIntEntry.attrVal = indices[MIDDLE_INDEX_LEAF].attrVal;
+        newIntEntry.attrVal = indices[middleIndex].attrVal;
         newIntEntry.lChild = blockNum;
         newIntEntry.rChild = newRightBlk;
 
-        // insertIntoInternal(relId, attrName, parent of current block, new internal entry)
-        return insertIntoInternal(relId, attrName, blockHeader.pblock, newIntEntry);
+        // insertIntoInternal(relId, attrOffset, parent of current block, new internal entry)
+        return insertIntoInternal(relId, attrOffset, blockHeader.pblock, newIntEntry);
 
     } else {
         // the current block was the root block and is now split. a new internal index
         // block needs to be allocated and made the root of the tree.
         // To do this, call the createNewRoot() function with the following arguments
 
-        // createNewRoot(relId, attrName, indices[MIDDLE_INDEX_LEAF].attrVal,
+        // createNewRoot(relId, attrOffset, indices[middleIndex].attrVal,
         //               current block, new right block)
-        return createNewRoot(relId, attrName, indices[MIDDLE_INDEX_LEAF].attrVal, blockNum, newRightBlk);
+        return createNewRoot(relId, attrOffset, indices[middleIndex].attrVal, blockNum, newRightBlk);
     }
 
     // if either of the above calls returned an error (E_DISKFULL), then return that
@@ -601,7 +977,8 @@ int BPlusTree::insertIntoLeaf(int relId, char attrName[ATTR_SIZE], int blockNum,
 int BPlusTree::splitLeaf(int leafBlockNum, Index indices[]) {
     // declare rightBlk, an instance of IndLeaf using constructor 1 to obtain new
     // leaf index block that will be used as the right block in the splitting
-    IndLeaf rightBlk;
+    // (placed after the existing leaf block if possible)
+    IndLeaf rightBlk(AfterBlock{leafBlockNum});
 
     // declare leftBlk, an instance of IndLeaf using constructor 2 to read from
     // the existing leaf block
@@ -624,27 +1001,27 @@ int BPlusTree::splitLeaf(int leafBlockNum, Index indices[]) {
     rightBlk.getHeader(&rightBlkHeader);
 
     // set rightBlkHeader with the following values
-    // - number of entries = (MAX_KEYS_LEAF+1)/2 = 32,
+    // - number of entries = (IndLeaf::getMaxKeys()+1)/2 (32 for 2048 byte blocks),
     // - pblock = pblock of leftBlk
     // - lblock = leftBlkNum
     // - rblock = rblock of leftBlk
     // and update the header of rightBlk using BlockBuffer::setHeader()
-    rightBlkHeader.numEntries = (MAX_KEYS_LEAF + 1) / 2;
+    rightBlkHeader.numEntries = (IndLeaf::getMaxKeys() + 1) / 2;
     rightBlkHeader.pblock = leftBlkHeader.pblock;
     rightBlkHeader.lblock = leftBlkNum;
     rightBlkHeader.rblock = leftBlkHeader.rblock;
     rightBlk.setHeader(&rightBlkHeader);
 
     // set leftBlkHeader with the following values
-    // - number of entries = (MAX_KEYS_LEAF+1)/2 = 32
+    // - number of entries = (IndLeaf::getMaxKeys()+1)/2
     // - rblock = rightBlkNum
     // and update the header of leftBlk using BlockBuffer::setHeader() */
-    leftBlkHeader.numEntries = (MAX_KEYS_LEAF + 1) / 2;
+    leftBlkHeader.numEntries = (IndLeaf::getMaxKeys() + 1) / 2;
     leftBlkHeader.rblock = rightBlkNum;
     leftBlk.setHeader(&leftBlkHeader);
 
-    // set the first 32 entries of leftBlk = the first 32 entries of indices array
-    // and set the first 32 entries of newRightBlk = the next 32 entries of
+    // set the first half of the entries of indices array in leftBlk
+    // and set the entries of newRightBlk = the next half of the entries of
     // indices array using IndLeaf::setEntry().
     for (int i = 0; i < leftBlkHeader.numEntries; i++) {
         leftBlk.setEntry(&indices[i], i);
@@ -658,11 +1035,11 @@ int BPlusTree::splitLeaf(int leafBlockNum, Index indices[]) {
 
 /* Used to insert an index entry into an internal index block of an existing B+ tree. This 
 function will call itself to handle any updation required to it's parent internal index blocks. */
-int BPlusTree::insertIntoInternal(int relId, char attrName[ATTR_SIZE], int intBlockNum, InternalEntry intEntry) {
-    // get the attribute cache entry corresponding to attrName
+int BPlusTree::insertIntoInternal(int relId, int attrOffset, int intBlockNum, InternalEntry intEntry) {
+    // get the attribute cache entry of the attribute at attrOffset
     // using AttrCacheTable::getAttrCatEntry().
     AttrCatEntry attrCatEntry;
-    AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    AttrCacheTable::getAttrCatEntry(relId, attrOffset, &attrCatEntry);
 
     // declare intBlk, an instance of IndInternal using constructor 2 for the block
     // corresponding to intBlockNum
@@ -717,7 +1094,7 @@ int BPlusTree::insertIntoInternal(int relId, char attrName[ATTR_SIZE], int intBl
         internalEntries[i - 1].rChild = intEntry.lChild;
     }
 
-    if (blockHeader.numEntries != MAX_KEYS_INTERNAL) {
+    if (blockHeader.numEntries != IndInternal::getMaxKeys()) {
         // (internal index block has not reached max limit)
 
         // increment blockheader.numEntries and update the header of intBlk
@@ -742,6 +1119,7 @@ int BPlusTree::insertIntoInternal(int relId, char attrName[ATTR_SIZE], int intBl
     // E_DISKFULL if there are no more blocks to be allocated.
 
     int newRightBlk = splitInternal(intBlockNum, internalEntries);
+    int middleIndex = IndInternal::getMaxKeys() / 2;
 
     /* if splitInternal() returned E_DISKFULL */
     if (newRightBlk == E_DISKFULL) {
@@ -759,29 +1137,29 @@ int BPlusTree::insertIntoInternal(int relId, char attrName[ATTR_SIZE], int intBl
         // insert the middle value from `internalEntries` into the parent block
         // using the insertIntoInternal() function (recursively).
 
-        // the middle value will be at index 50 (given by constant MIDDLE_INDEX_INTERNAL)
+        // the middle value will be at index middleIndex (50 for 2048 byte blocks)
 
         // create a struct InternalEntry with lChild = current block, rChild = newRightBlk
-        // and attrVal = internalEntries[MIDDLE_INDEX_INTERNAL].attrVal
+        // and attrVal = internalEntries[middleIndex].attrVal
         // and pass it as argument to the insertIntoInternalFunction as follows
         InternalEntry newIntEntry;
 
         newIntEntry.lChild = intBlockNum;
-        newIntEntry.attrVal = internalEntries[MIDDLE_INDEX_INTERNAL].attrVal;
+        newIntEntry.attrVal = internalEntries[middleIndex].attrVal;
         newIntEntry.rChild = newRightBlk;
         
-        // insertIntoInternal(relId, attrName, parent of current block, new internal entry)
-        return insertIntoInternal(relId, attrName, blockHeader.pblock, newIntEntry);
+        // insertIntoInternal(relId, attrOffset, parent of current block, new internal entry)
+        return insertIntoInternal(relId, attrOffset, blockHeader.pblock, newIntEntry);
 
     } else {
         // the current block was the root block and is now split. a new internal index
         // block needs to be allocated and made the root of the tree.
         // To do this, call the createNewRoot() function with the following arguments
 
-        // createNewRoot(relId, attrName,
-        //               internalEntries[MIDDLE_INDEX_INTERNAL].attrVal,
+        // createNewRoot(relId, attrOffset,
+        //               internalEntries[middleIndex].attrVal,
         //               current block, new right block)
-        return createNewRoot(relId, attrName, internalEntries[MIDDLE_INDEX_INTERNAL].attrVal, intBlockNum, newRightBlk);
+        return createNewRoot(relId, attrOffset, internalEntries[middleIndex].attrVal, intBlockNum, newRightBlk);
     }
 
     // if either of the above calls returned an error (E_DISKFULL), then return that
@@ -793,7 +1171,8 @@ internal index block and a newly allocated internal index block. */
 int BPlusTree::splitInternal(int intBlockNum, InternalEntry internalEntries[]) {
     // declare rightBlk, an instance of IndInternal using constructor 1 to obtain new
     // internal index block that will be used as the right block in the splitting
-    IndInternal rightBlk;
+    // (placed after the existing internal index block if possible)
+    IndInternal rightBlk(AfterBlock{intBlockNum});
 
     // declare leftBlk, an instance of IndInternal using constructor 2 to read from
     // the existing internal index block
@@ -815,34 +1194,38 @@ int BPlusTree::splitInternal(int intBlockNum, InternalEntry internalEntries[]) {
     leftBlk.getHeader(&leftBlkHeader);
     rightBlk.getHeader(&rightBlkHeader);
 
+    // index of the entry moving to the parent (50 for 2048 byte blocks)
+    int middleIndex = IndInternal::getMaxKeys() / 2;
+
     // set rightBlkHeader with the following values
-    // - number of entries = (MAX_KEYS_INTERNAL)/2 = 50
+    // - number of entries = middleIndex
     // - pblock = pblock of leftBlk
     // and update the header of rightBlk using BlockBuffer::setHeader()
-    rightBlkHeader.numEntries = (MAX_KEYS_INTERNAL) / 2;
+    rightBlkHeader.numEntries = middleIndex;
     rightBlkHeader.pblock = leftBlkHeader.pblock;
     rightBlk.setHeader(&rightBlkHeader);
 
     // set leftBlkHeader with the following values
-    // - number of entries = (MAX_KEYS_INTERNAL)/2 = 50
+    // - number of entries = middleIndex
     // - rblock = rightBlkNum
     // and update the header using BlockBuffer::setHeader()
-    leftBlkHeader.numEntries = (MAX_KEYS_INTERNAL) / 2;
+    leftBlkHeader.numEntries = middleIndex;
     leftBlkHeader.rblock = rightBlkNum;
     leftBlk.setHeader(&leftBlkHeader);
 
     /*
-    - set the first 50 entries of leftBlk = index 0 to 49 of internalEntries
-      array
-    - set the first 50 entries of newRightBlk = entries from index 51 to 100
-      of internalEntries array using IndInternal::setEntry().
-      (index 50 will be moving to the parent internal index block)
+    - set the first middleIndex entries of leftBlk = index 0 to middleIndex - 1
+      of internalEntries array
+    - set the first middleIndex entries of newRightBlk = entries from index
+      middleIndex + 1 to 2 * middleIndex of internalEntries array using
+      IndInternal::setEntry().
+      (index middleIndex will be moving to the parent internal index block)
     */
     for (int i = 0; i < leftBlkHeader.numEntries; i++) {
         leftBlk.setEntry(&internalEntries[i], i);
     }
     for (int i = 0; i < rightBlkHeader.numEntries; i++) {
-        rightBlk.setEntry(&internalEntries[i + MIDDLE_INDEX_INTERNAL + 1], i);
+        rightBlk.setEntry(&internalEntries[i + middleIndex + 1], i);
     }
 
     /* block type of a child of any entry of the internalEntries array */
@@ -850,18 +1233,18 @@ int BPlusTree::splitInternal(int intBlockNum, InternalEntry internalEntries[]) {
     int type = StaticBuffer::getStaticBlockType(internalEntries[0].lChild); 
 
     /* for each child block of the new right block */ 
-    BlockBuffer childBlk (internalEntries[MIDDLE_INDEX_INTERNAL + 1].lChild);
+    BlockBuffer childBlk (internalEntries[middleIndex + 1].lChild);
 
     HeadInfo childHeader;
     childBlk.getHeader(&childHeader);
     childHeader.pblock = rightBlkNum;
     childBlk.setHeader(&childHeader);
 
-    for (int i = 0; i < MIDDLE_INDEX_INTERNAL; i++)
+    for (int i = 0; i < middleIndex; i++)
     {
         // declare an instance of BlockBuffer to access the child block using
         // constructor 2
-        BlockBuffer childBlk(internalEntries[i + MIDDLE_INDEX_INTERNAL + 1].rChild);
+        BlockBuffer childBlk(internalEntries[i + middleIndex + 1].rChild);
 
         // update pblock of the block to rightBlkNum using BlockBuffer::getHeader()
         // and BlockBuffer::setHeader().
@@ -876,11 +1259,11 @@ int BPlusTree::splitInternal(int intBlockNum, InternalEntry internalEntries[]) {
 
 /* This function will allocate a new root block and update the attribute cache 
 entry of the attribute in the specified relation to point to the new root block. */
-int BPlusTree::createNewRoot(int relId, char attrName[ATTR_SIZE], Attribute attrVal, int lChild, int rChild) {
-    // get the attribute cache entry corresponding to attrName
+int BPlusTree::createNewRoot(int relId, int attrOffset, Attribute attrVal, int lChild, int rChild) {
+    // get the attribute cache entry of the attribute at attrOffset
     // using AttrCacheTable::getAttrCatEntry().
     AttrCatEntry attrCatEntry;
-    AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    AttrCacheTable::getAttrCatEntry(relId, attrOffset, &attrCatEntry);
 
     // declare newRootBlk, an instance of IndInternal using appropriate constructor
     // to allocate a new internal index block on the disk
@@ -931,10 +1314,10 @@ int BPlusTree::createNewRoot(int relId, char attrName[ATTR_SIZE], Attribute attr
     lChildBlk.setHeader(&lChildHeader);
     rChildBlk.setHeader(&rChildHeader);
 
-    // update rootBlock = newRootBlkNum for the entry corresponding to `attrName`
+    // update rootBlock = newRootBlkNum for the entry of the attribute at attrOffset
     // in the attribute cache using AttrCacheTable::setAttrCatEntry().
     attrCatEntry.rootBlock = newRootBlkNum;
-    AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+    AttrCacheTable::setAttrCatEntry(relId, attrOffset, &attrCatEntry);
 
     return SUCCESS;
 }
\ No newline at end of file
@@ -10,16 +10,22 @@
 class BPlusTree {
  private:
   static int findLeafToInsert(int rootBlock, Attribute attrVal, int attrType);
-  static int insertIntoLeaf(int relId, char attrName[ATTR_SIZE], int blockNum, Index entry);
+  static int insertIntoLeaf(int relId, int attrOffset, int blockNum, Index entry);
   static int splitLeaf(int leafBlockNum, Index indices[]);
-  static int insertIntoInternal(int relId, char attrName[ATTR_SIZE], int intBlockNum, InternalEntry entry);
+  static int insertIntoInternal(int relId, int attrOffset, int intBlockNum, InternalEntry entry);
   static int splitInternal(int intBlockNum, InternalEntry internalEntries[]);
-  static int createNewRoot(int relId, char attrName[ATTR_SIZE], Attribute attrVal, int lChild, int rChild);
+  static int createNewRoot(int relId, int attrOffset, Attribute attrVal, int lChild, int rChild);
+  static int buildBottomUp(Index entries[], int numEntries);
+  static int removeFromLeaf(int rootBlock, Index entry, int attrType);
 
  public:
   static int bPlusCreate(int relId, char attrName[ATTR_SIZE]);
-  static int bPlusInsert(int relId, char attrName[ATTR_SIZE], union Attribute attrVal, RecId recordId);
+  static int bPlusInsert(int relId, int attrOffset, union Attribute attrVal, RecId recordId);
+  static int bPlusBulkInsert(int relId, char attrName[ATTR_SIZE], Index entries[], int numEntries);
+  static int bPlusBulkDelete(int relId, int attrOffset, Index entries[], int numEntries);
   static RecId bPlusSearch(int relId, char attrName[ATTR_SIZE], union Attribute attrVal, int op);
+  static RecId bPlusSearch(int relId, int attrOffset, union Attribute attrVal, int op);
+  static int bPlusMinMax(int relId, char attrName[ATTR_SIZE], int aggOp, union Attribute *attrVal);
   static int bPlusDestroy(int rootBlockNum);
 };
 
@@ -1,12 +1,25 @@
 #include "BlockAccess.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <vector>
+
+#include "../Statistics/Statistics.h"
 
 /*  This method searches the relation specified linearly to find the next record that satisfies the specified 
     condition. The condition value is given by the argument attrVal. This function returns the recId of the next 
     record satisfying the condition. The condition that is checked for is the following. 
 */
-RecId BlockAccess::linearSearch(int relId, char attrName[ATTR_SIZE], union Attribute attrVal, int op) {
+RecId BlockAccess::linearSearch(int relId, int attrOffset, union Attribute attrVal, int op) {
+    // get the type of the attribute from the attribute cache entry of the relation
+    // (use AttrCacheTable::getAttrCatEntry())
+    AttrCatEntry attrCatEntry;
+    if (AttrCacheTable::getAttrCatEntry(relId, attrOffset, &attrCatEntry) != SUCCESS) {
+        return RecId{-1, -1};
+    }
+    int attrType = attrCatEntry.attrType;
+
     // get the previous search index of the relation relId from the relation cache
     // (use RelCacheTable::getSearchIndex() function)
     RecId prevRecId;
@@ -85,21 +98,13 @@ RecId BlockAccess::linearSearch(int relId, char attrName[ATTR_SIZE], union Attri
         }
 
         // compare record's attribute value to the the given attrVal as below:
-        /*
-            firstly get the attribute offset for the attrName attribute
-            from the attribute cache entry of the relation using
-            AttrCacheTable::getAttrCatEntry()
-        */
-        AttrCatEntry entry;
-        AttrCacheTable::getAttrCatEntry(relId, attrName, &entry);
-
         /* use the attribute offset to get the value of the attribute from
            current record */
-        Attribute val = record[entry.offset];
+        Attribute val = record[attrOffset];
 
         int cmpVal;  // will store the difference between the attributes
         // set cmpVal using compareAttrs()
-        cmpVal = compareAttrs(val, attrVal, entry.attrType);
+        cmpVal = compareAttrs(val, attrVal, attrType);
 
         /* Next task is to check whether this record satisfies the given condition.
            It is determined based on the output of previous comparison and
@@ -138,17 +143,12 @@ RecId BlockAccess::linearSearch(int relId, char attrName[ATTR_SIZE], union Attri
     newName - newname of relation
 */
 int BlockAccess::renameRelation(char oldName[ATTR_SIZE], char newName[ATTR_SIZE]) {
-    /* reset the searchIndex of the relation catalog using
-       RelCacheTable::resetSearchIndex() */
-    RelCacheTable::resetSearchIndex(RELCAT_RELID);
-
     Attribute newRelationName;    // set newRelationName with newName
     strcpy(newRelationName.sVal, newName);
 
-    // search the relation catalog for an entry with "RelName" = newRelationName
-    char attrName[ATTR_SIZE];
-    strcpy(attrName, RELCAT_ATTR_RELNAME);
-    RecId searchRes = linearSearch(RELCAT_RELID, attrName, newRelationName, EQ);
+    // look up the relation catalog for an entry with "RelName" = newRelationName
+    // (using the index of the relation catalog by name)
+    RecId searchRes = RelCacheTable::getRelCatRecId(newName);
 
     // If relation with name newName already exists (result of linearSearch
     //                                               is not {-1, -1})
@@ -157,15 +157,8 @@ int BlockAccess::renameRelation(char oldName[ATTR_SIZE], char newName[ATTR_SIZE]
         return E_RELEXIST;
     }
 
-    /* reset the searchIndex of the relation catalog using
-       RelCacheTable::resetSearchIndex() */
-    RelCacheTable::resetSearchIndex(RELCAT_RELID);
-
-    Attribute oldRelationName;    // set oldRelationName with oldName
-    strcpy(oldRelationName.sVal, oldName);
-
-    // search the relation catalog for an entry with "RelName" = oldRelationName
-    searchRes = linearSearch(RELCAT_RELID, attrName, oldRelationName, EQ);
+    // look up the relation catalog for an entry with "RelName" = oldName
+    searchRes = RelCacheTable::getRelCatRecId(oldName);
 
     // If relation with name oldName does not exist (result of linearSearch is {-1, -1})
     //    return E_RELNOTEXIST;
@@ -185,33 +178,29 @@ int BlockAccess::renameRelation(char oldName[ATTR_SIZE], char newName[ATTR_SIZE]
        // set back the record value using RecBuffer.setRecord
     relRec[RELCAT_REL_NAME_INDEX] = newRelationName;
     relBlock.setRecord(relRec, searchRes.slot);
+    RelCacheTable::setRelCatRecId(oldName, RecId{-1, -1});
+    RelCacheTable::setRelCatRecId(newName, searchRes);
 
     /*
     update all the attribute catalog entries in the attribute catalog corresponding
     to the relation with relation name oldName to the relation name newName
     */
 
-    /* reset the searchIndex of the attribute catalog using
-       RelCacheTable::resetSearchIndex() */
-    strcpy(attrName, ATTRCAT_ATTR_RELNAME);
-    RelCacheTable::resetSearchIndex(ATTRCAT_RELID);
-
-    //for i = 0 to numberOfAttributes :
-    //    linearSearch on the attribute catalog for relName = oldRelationName
+    //for each attribute catalog entry of the relation (found using the index of
+    //the attribute catalog by relation name):
     //    get the record using RecBuffer.getRecord
     //
     //    update the relName field in the record to newName
     //    set back the record using RecBuffer.setRecord
-    int noOfAttrs = relRec[RELCAT_NO_ATTRIBUTES_INDEX].nVal;
-    for (int i = 0; i < noOfAttrs; i++) {
-        searchRes = linearSearch(ATTRCAT_RELID, attrName, oldRelationName, EQ);
-
-        relBlock = RecBuffer(searchRes.block);
-        relBlock.getRecord(relRec, searchRes.slot);
+    for (RecId attrCatRecId : AttrCacheTable::getAttrCatRecIds(oldName)) {
+        RecBuffer attrCatBlock(attrCatRecId.block);
+        Attribute attrCatRecord[ATTRCAT_NO_ATTRS];
+        attrCatBlock.getRecord(attrCatRecord, attrCatRecId.slot);
 
-        relRec[ATTRCAT_REL_NAME_INDEX] = newRelationName;
-        relBlock.setRecord(relRec, searchRes.slot);
+        attrCatRecord[ATTRCAT_REL_NAME_INDEX] = newRelationName;
+        attrCatBlock.setRecord(attrCatRecord, attrCatRecId.slot);
     }
+    AttrCacheTable::renameAttrCatRecIds(oldName, newName);
 
     return SUCCESS;
 }
@@ -220,56 +209,33 @@ int BlockAccess::renameRelation(char oldName[ATTR_SIZE], char newName[ATTR_SIZE]
     specified relation, to the new name specified in arguments. */
 int BlockAccess::renameAttribute(char relName[ATTR_SIZE], char oldName[ATTR_SIZE], char newName[ATTR_SIZE]) {
 
-    /* reset the searchIndex of the relation catalog using
-       RelCacheTable::resetSearchIndex() */
-    RelCacheTable::resetSearchIndex(RELCAT_RELID);
-
-    Attribute relNameAttr;    // set relNameAttr to relName
-    strcpy(relNameAttr.sVal, relName);
-
-    // Search for the relation with name relName in relation catalog using linearSearch()
+    // Look up the relation with name relName in relation catalog using RelCacheTable::getRelCatRecId()
     // If relation with name relName does not exist (search returns {-1,-1})
     //    return E_RELNOTEXIST;
-    char attrName[ATTR_SIZE];
-    strcpy(attrName, RELCAT_ATTR_RELNAME);
-    RecId searchRes = linearSearch(RELCAT_RELID, attrName, relNameAttr, EQ);
+    RecId searchRes = RelCacheTable::getRelCatRecId(relName);
 
     if (searchRes.block == -1 && searchRes.slot == -1) {
         return E_RELNOTEXIST;
     }
 
-    /* reset the searchIndex of the attribute catalog using
-       RelCacheTable::resetSearchIndex() */
-    RelCacheTable::resetSearchIndex(ATTRCAT_RELID);
-
     /* declare variable attrToRenameRecId used to store the attr-cat recId
     of the attribute to rename */
     RecId attrToRenameRecId{ -1, -1 };
     Attribute attrCatEntryRecord[ATTRCAT_NO_ATTRS];
 
     /* iterate over all Attribute Catalog Entry record corresponding to the
-       relation to find the required attribute */
-    while (true) {
-        // linear search on the attribute catalog for RelName = relNameAttr
-        searchRes = linearSearch(ATTRCAT_RELID, attrName, relNameAttr, EQ);
-        /* NOTE --> Here attrName need not be loaded again from ATTRCAT_ATTR_RELNAME,
-        because both are same */
-
-        // if there are no more attributes left to check (linearSearch returned {-1,-1})
-        //     break;
-        if (searchRes.block == -1 && searchRes.slot == -1) {
-            break;
-        }
-
+       relation (using the index of the attribute catalog by relation name)
+       to find the required attribute */
+    for (RecId attrCatRecId : AttrCacheTable::getAttrCatRecIds(relName)) {
         /* Get the record from the attribute catalog using RecBuffer.getRecord
           into attrCatEntryRecord */
-        RecBuffer attrCatBlock(searchRes.block);
-        attrCatBlock.getRecord(attrCatEntryRecord, searchRes.slot);
+        RecBuffer attrCatBlock(attrCatRecId.block);
+        attrCatBlock.getRecord(attrCatEntryRecord, attrCatRecId.slot);
 
         // if attrCatEntryRecord.attrName = oldName
         //     attrToRenameRecId = block and slot of this record
         if (strcmp(attrCatEntryRecord[ATTRCAT_ATTR_NAME_INDEX].sVal, oldName) == 0) {
-            attrToRenameRecId = searchRes;
+            attrToRenameRecId = attrCatRecId;
         }
 
         // if attrCatEntryRecord.attrName = newName
@@ -375,11 +341,12 @@ int BlockAccess::insert(int relId, Attribute *record) {
         // get the block number of the newly allocated block
         // (use BlockBuffer::getBlockNum() function)
         // let ret be the return value of getBlockNum() function call
-        RecBuffer newBlock;
-        int ret = newBlock.getBlockNum();
+        // (getNewRecBlock() places it after the last block of the relation)
+        int ret = getNewRecBlock(relId, 1);
         if (ret == E_DISKFULL) {
             return E_DISKFULL;
         }
+        RecBuffer newBlock(ret);
 
         // Assign rec_id.block = new block number(i.e. ret) and rec_id.slot = 0
         rec_id.block = ret;
@@ -436,21 +403,24 @@ int BlockAccess::insert(int relId, Attribute *record) {
         else
         {
             // update first block field in the relation catalog entry to the
-            // new block (using RelCacheTable::setRelCatEntry() function)
+            // new block
             relCatEntry.firstBlk = rec_id.block;
-            RelCacheTable::setRelCatEntry(relId, &relCatEntry);
         }
 
         // update last block field in the relation catalog entry to the
-        // new block (using RelCacheTable::setRelCatEntry() function)
+        // new block
         relCatEntry.lastBlk = rec_id.block;
-        RelCacheTable::setRelCatEntry(relId, &relCatEntry);
     }
 
     // create a RecBuffer object for rec_id.block
     // insert the record into rec_id'th slot using RecBuffer.setRecord())
     RecBuffer insRecBlock(rec_id.block);
     insRecBlock.setRecord(record, rec_id.slot);
+    if (relId == RELCAT_RELID) {
+        RelCacheTable::setRelCatRecId(record[RELCAT_REL_NAME_INDEX].sVal, rec_id);
+    } else if (relId == ATTRCAT_RELID) {
+        AttrCacheTable::addAttrCatRecId(record[ATTRCAT_REL_NAME_INDEX].sVal, rec_id);
+    }
 
     /* update the slot map of the block by marking entry of the slot to
        which record was inserted as occupied) */
@@ -470,7 +440,8 @@ int BlockAccess::insert(int relId, Attribute *record) {
     insRecBlock.setHeader(&head);
 
     // Increment the number of records field in the relation cache entry for
-    // the relation. (use RelCacheTable::setRelCatEntry function)
+    // the relation, and store the entry with the block fields updated above
+    // in one call (use RelCacheTable::setRelCatEntry function)
     relCatEntry.numRecs++;
     RelCacheTable::setRelCatEntry(relId, &relCatEntry);
 
@@ -492,8 +463,7 @@ int BlockAccess::insert(int relId, Attribute *record) {
         if (rootBlk != -1) {
             /* insert the new record into the attribute's bplus tree using
              BPlusTree::bPlusInsert()*/
-            int retVal = BPlusTree::bPlusInsert(relId, attrCatEntry.attrName,
-                                                record[attrOffset], rec_id);
+            int retVal = BPlusTree::bPlusInsert(relId, attrOffset, record[attrOffset], rec_id);
 
             if (retVal == E_DISKFULL) {
                 //(index for this attribute has been destroyed)
@@ -506,37 +476,503 @@ int BlockAccess::insert(int relId, Attribute *record) {
     return flag;
 }
 
+/* Allocates a new record block for the relation and returns its block number (or
+   E_DISKFULL). The block is taken from a run of blocks preallocated for the relation
+   right after its last block, so that its record blocks stay contiguous even while other
+   relations grow. When the run is used up, the next run is as long as the relation already
+   is (at least numBlocks, the blocks the caller is about to fill, and at most
+   MAX_RESERVED_BLOCKS), so the runs double in length as the relation grows. */
+int BlockAccess::getNewRecBlock(int relId, int numBlocks) {
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+
+    int reservedBlk, numReserved;
+    RelCacheTable::getReservedBlocks(relId, &reservedBlk, &numReserved);
+
+    if (numReserved == 0) {
+        int relBlocks = relCatEntry.numRecs / relCatEntry.numSlotsPerBlk;
+        int goalBlock = relCatEntry.lastBlk == -1 ? -1 : relCatEntry.lastBlk + 1;
+        reservedBlk = StaticBuffer::reserveBlocks(goalBlock, std::min(MAX_RESERVED_BLOCKS, std::max(numBlocks, relBlocks)),
+                                                  &numReserved);
+
+        // if the disk is full but for blocks preallocated for other relations, take one of them
+        if (reservedBlk == E_DISKFULL) {
+            RecBuffer newBlock(AfterBlock{relCatEntry.lastBlk});
+            return countNewRecBlock(relId, newBlock.getBlockNum());
+        }
+    }
+
+    // the first preallocated block is given out as the block after the one before it
+    RecBuffer newBlock(AfterBlock{reservedBlk - 1});
+    RelCacheTable::setReservedBlocks(relId, reservedBlk + 1, numReserved - 1);
+    return countNewRecBlock(relId, newBlock.getBlockNum());
+}
+
+/* Adds the block allocated by getNewRecBlock() (unless it is E_DISKFULL) to the record
+   block count of the relation, if that has been counted, and returns blockNum. */
+int BlockAccess::countNewRecBlock(int relId, int blockNum) {
+    int numBlocks;
+    RelCacheTable::getNumBlocks(relId, &numBlocks);
+    if (blockNum >= 0 && numBlocks != -1) {
+        RelCacheTable::setNumBlocks(relId, numBlocks + 1);
+    }
+    return blockNum;
+}
+
+/* Returns the number of record blocks of the relation. It is counted by walking the block
+   list the first time it is needed after the relation is opened, and kept up to date by
+   getNewRecBlock() and deleteRecords() from then on. Blocks left sparse by deletions are
+   counted too: a linear scan reads them all. */
+int BlockAccess::getNumRecBlocks(int relId) {
+    int numBlocks;
+    RelCacheTable::getNumBlocks(relId, &numBlocks);
+    if (numBlocks != -1) {
+        return numBlocks;
+    }
+
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+
+    numBlocks = 0;
+    for (int blockNum = relCatEntry.firstBlk; blockNum != -1; numBlocks++) {
+        RecBuffer recBlock(blockNum);
+        HeadInfo head;
+        recBlock.getHeader(&head);
+        blockNum = head.rblock;
+    }
+
+    RelCacheTable::setNumBlocks(relId, numBlocks);
+    return numBlocks;
+}
+
+/* Appends numRecords records (stored one after the other in `records`) to the relation.
+   The free slots of the existing record blocks are filled first. Unlike insert(), the block
+   list is not searched from its start on every call: the relation cache remembers the first
+   block that may still have a free slot (set when the relation is opened and when records
+   are deleted), so a relation with no holes only has its last block checked. The rest of
+   the records are written into new blocks that are linked in as they are filled. The
+   relation catalog entry is updated once, and
+   B+ tree maintenance is deferred to the end of the batch, when the sorted entries of the
+   batch are merged into each index of the relation. The number of records written is
+   stored in numInserted (less than numRecords only if the disk runs out of blocks). */
+int BlockAccess::bulkInsert(int relId, Attribute *records, int numRecords, int *numInserted) {
+    *numInserted = 0;
+
+    // the catalogs are filled by the Schema layer one record at a time
+    if (relId == RELCAT_RELID || relId == ATTRCAT_RELID) {
+        return E_NOTPERMITTED;
+    }
+
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+
+    int numOfSlots = relCatEntry.numSlotsPerBlk;
+    int numOfAttributes = relCatEntry.numAttrs;
+
+    // rec-ids of the written records, used to build the index entries
+    std::vector<RecId> recIds(numRecords);
+    int inserted = 0;
+    int retVal = SUCCESS;
+
+    // fill the free slots of the existing record blocks, from the first one that may have any
+    // (the last block always may)
+    int blockNum;
+    RelCacheTable::getFreeSlotBlock(relId, &blockNum);
+    if (blockNum == -1) {
+        blockNum = relCatEntry.lastBlk;
+    }
+
+    while (blockNum != -1) {
+        RecBuffer recBlock(blockNum);
+
+        HeadInfo head;
+        recBlock.getHeader(&head);
+
+        if (head.numEntries < numOfSlots) {
+            unsigned char slotMap[numOfSlots];
+            recBlock.getSlotMap(slotMap);
+
+            for (int slot = 0; slot < numOfSlots && inserted < numRecords; slot++) {
+                if (slotMap[slot] == SLOT_UNOCCUPIED) {
+                    recBlock.setRecord(records + inserted * numOfAttributes, slot);
+                    slotMap[slot] = SLOT_OCCUPIED;
+                    recIds[inserted++] = {blockNum, slot};
+                    head.numEntries++;
+                }
+            }
+
+            recBlock.setSlotMap(slotMap);
+            recBlock.setHeader(&head);
+        }
+
+        if (inserted == numRecords) {
+            break;
+        }
+        blockNum = head.rblock;
+    }
+
+    // (the blocks before blockNum are now full)
+    RelCacheTable::setFreeSlotBlock(relId, blockNum == relCatEntry.lastBlk ? -1 : blockNum);
+
+    // write the remaining records into new blocks, each filled before the next is allocated
+    while (inserted < numRecords) {
+        int blockNum = getNewRecBlock(relId, (numRecords - inserted + numOfSlots - 1) / numOfSlots);
+        if (blockNum == E_DISKFULL) {
+            retVal = E_DISKFULL;
+            break;
+        }
+        RecBuffer newBlock(blockNum);
+
+        int count = std::min(numOfSlots, numRecords - inserted);
+
+        HeadInfo head;
+        head.blockType = REC;
+        head.pblock = -1;
+        head.lblock = relCatEntry.lastBlk;
+        head.rblock = -1;
+        head.numEntries = count;
+        head.numSlots = numOfSlots;
+        head.numAttrs = numOfAttributes;
+        newBlock.setHeader(&head);
+
+        unsigned char slotMap[numOfSlots];
+        for (int slot = 0; slot < numOfSlots; slot++) {
+            slotMap[slot] = slot < count ? SLOT_OCCUPIED : SLOT_UNOCCUPIED;
+        }
+        newBlock.setSlotMap(slotMap);
+
+        for (int slot = 0; slot < count; slot++) {
+            newBlock.setRecord(records + inserted * numOfAttributes, slot);
+            recIds[inserted++] = {blockNum, slot};
+        }
+
+        // link the new block after the last block of the relation
+        if (relCatEntry.lastBlk != -1) {
+            RecBuffer prevBlock(relCatEntry.lastBlk);
+            prevBlock.getHeader(&head);
+            head.rblock = blockNum;
+            prevBlock.setHeader(&head);
+        } else {
+            relCatEntry.firstBlk = blockNum;
+        }
+        relCatEntry.lastBlk = blockNum;
+    }
+
+    relCatEntry.numRecs += inserted;
+    RelCacheTable::setRelCatEntry(relId, &relCatEntry);
+    *numInserted = inserted;
+
+    /* B+ Tree Insertions */
+
+    int flag = SUCCESS;
+    std::vector<Index> entries(inserted);
+    for (int attrOffset = 0; attrOffset < numOfAttributes; attrOffset++) {
+        AttrCatEntry attrCatEntry;
+        AttrCacheTable::getAttrCatEntry(relId, attrOffset, &attrCatEntry);
+
+        if (attrCatEntry.rootBlock == -1) {
+            continue;
+        }
+
+        // the index entries of the batch, in key order
+        for (int i = 0; i < inserted; i++) {
+            entries[i].attrVal = records[i * numOfAttributes + attrOffset];
+            entries[i].block = recIds[i].block;
+            entries[i].slot = recIds[i].slot;
+            memset(entries[i].unused, 0, sizeof(entries[i].unused));
+        }
+        int attrType = attrCatEntry.attrType;
+        std::stable_sort(entries.begin(), entries.end(), [attrType](const Index &a, const Index &b) {
+            return compareAttrs(a.attrVal, b.attrVal, attrType) < 0;
+        });
+
+        int ret = insertIndexEntries(relId, attrOffset, entries.data(), inserted, relCatEntry.numRecs - inserted);
+        if (ret == E_DISKFULL) {
+            // (index for this attribute has been destroyed)
+            flag = E_INDEX_BLOCKS_RELEASED;
+        }
+    }
+
+    return retVal == SUCCESS ? flag : retVal;
+}
+
+/* Inserts a batch of index entries, sorted on the attribute, into the B+ tree of the
+   attribute at attrOffset, which holds indexSize entries before the batch. */
+int BlockAccess::insertIndexEntries(int relId, int attrOffset, Index entries[], int numEntries, int indexSize) {
+    AttrCatEntry attrCatEntry;
+    AttrCacheTable::getAttrCatEntry(relId, attrOffset, &attrCatEntry);
+
+    /* merging rewrites every leaf of the index once, which is cheaper than one
+       bPlusInsert() per entry unless the batch is small next to the index */
+    if ((long long)numEntries * IndLeaf::getMaxKeys() >= indexSize) {
+        return BPlusTree::bPlusBulkInsert(relId, attrCatEntry.attrName, entries, numEntries);
+    }
+
+    int ret = SUCCESS;
+    for (int i = 0; i < numEntries && ret != E_DISKFULL; i++) {
+        RecId recId = {entries[i].block, entries[i].slot};
+        ret = BPlusTree::bPlusInsert(relId, attrOffset, entries[i].attrVal, recId);
+    }
+    return ret;
+}
+
+/* Deletes the records at the given rec-ids from the relation. Their entries are removed
+   from every B+ tree on the relation (one batch per index), then their slots are freed
+   block by block; a record block left empty is unlinked from the relation and released.
+   The freed slots are reused by later insertions. The relation catalog entry is updated
+   once. Returns E_INDEX_BLOCKS_RELEASED if an index had to be destroyed. */
+int BlockAccess::deleteRecords(int relId, RecId recIds[], int numRecIds) {
+    RelCatEntry relCatEntry;
+    int retVal = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+    if (retVal != SUCCESS) {
+        return retVal;
+    }
+
+    int numOfAttributes = relCatEntry.numAttrs;
+
+    // (the slots of a block are then freed together)
+    std::sort(recIds, recIds + numRecIds, [](const RecId &a, const RecId &b) {
+        return a.block < b.block || (a.block == b.block && a.slot < b.slot);
+    });
+
+    /* B+ Tree Deletions */
+
+    std::vector<int> indexedAttrs;
+    for (int attrOffset = 0; attrOffset < numOfAttributes; attrOffset++) {
+        AttrCatEntry attrCatEntry;
+        AttrCacheTable::getAttrCatEntry(relId, attrOffset, &attrCatEntry);
+        if (attrCatEntry.rootBlock != -1) {
+            indexedAttrs.push_back(attrOffset);
+        }
+    }
+
+    int flag = SUCCESS;
+    if (!indexedAttrs.empty() && numRecIds > 0) {
+        // the index entries of the records, read once for all the indexes
+        std::vector<std::vector<Index>> entries(indexedAttrs.size(), std::vector<Index>(numRecIds));
+        Attribute record[numOfAttributes];
+        for (int i = 0; i < numRecIds; i++) {
+            RecBuffer recBlk(recIds[i].block);
+            recBlk.getRecord(record, recIds[i].slot);
+
+            for (size_t k = 0; k < indexedAttrs.size(); k++) {
+                entries[k][i].attrVal = record[indexedAttrs[k]];
+                entries[k][i].block = recIds[i].block;
+                entries[k][i].slot = recIds[i].slot;
+                memset(entries[k][i].unused, 0, sizeof(entries[k][i].unused));
+            }
+        }
+
+        for (size_t k = 0; k < indexedAttrs.size(); k++) {
+            AttrCatEntry attrCatEntry;
+            AttrCacheTable::getAttrCatEntry(relId, indexedAttrs[k], &attrCatEntry);
+
+            // the batch in key order
+            int attrType = attrCatEntry.attrType;
+            std::stable_sort(entries[k].begin(), entries[k].end(), [attrType](const Index &a, const Index &b) {
+                return compareAttrs(a.attrVal, b.attrVal, attrType) < 0;
+            });
+
+            if (BPlusTree::bPlusBulkDelete(relId, indexedAttrs[k], entries[k].data(), numRecIds) == E_DISKFULL) {
+                // (index for this attribute has been destroyed)
+                flag = E_INDEX_BLOCKS_RELEASED;
+            }
+        }
+    }
+
+    /* Freeing the slots */
+
+    for (int i = 0; i < numRecIds;) {
+        int blockNum = recIds[i].block;
+        RecBuffer recBlk(blockNum);
+
+        HeadInfo head;
+        recBlk.getHeader(&head);
+
+        unsigned char slotMap[head.numSlots];
+        recBlk.getSlotMap(slotMap);
+
+        for (; i < numRecIds && recIds[i].block == blockNum; i++) {
+            if (slotMap[recIds[i].slot] == SLOT_OCCUPIED) {
+                slotMap[recIds[i].slot] = SLOT_UNOCCUPIED;
+                head.numEntries--;
+                relCatEntry.numRecs--;
+            }
+        }
+
+        if (head.numEntries > 0) {
+            recBlk.setSlotMap(slotMap);
+            recBlk.setHeader(&head);
+            continue;
+        }
+
+        // unlink the empty block from the linked list of record blocks and release it
+        HeadInfo adjHead;
+        if (head.lblock != -1) {
+            RecBuffer prevBlk(head.lblock);
+            prevBlk.getHeader(&adjHead);
+            adjHead.rblock = head.rblock;
+            prevBlk.setHeader(&adjHead);
+        } else {
+            relCatEntry.firstBlk = head.rblock;
+        }
+
+        if (head.rblock != -1) {
+            RecBuffer nextBlk(head.rblock);
+            nextBlk.getHeader(&adjHead);
+            adjHead.lblock = head.lblock;
+            nextBlk.setHeader(&adjHead);
+        } else {
+            relCatEntry.lastBlk = head.lblock;
+        }
+
+        recBlk.releaseBlock();
+
+        int numBlocks;
+        RelCacheTable::getNumBlocks(relId, &numBlocks);
+        if (numBlocks != -1) {
+            RelCacheTable::setNumBlocks(relId, numBlocks - 1);
+        }
+    }
+
+    RelCacheTable::setRelCatEntry(relId, &relCatEntry);
+
+    // the freed slots are reused by later calls to bulkInsert()
+    RelCacheTable::setFreeSlotBlock(relId, relCatEntry.firstBlk);
+
+    return flag;
+}
+
+/* Sets the attributes at attrOffsets[0..numValues-1] to values[] in the records at the
+   given rec-ids, rewriting each record in place. Only the B+ trees of the attributes being
+   set are updated, and only for the records whose value changes: the old entries are
+   removed and the new ones inserted, one batch per index. The records and the blocks of
+   the relation stay where they are. Returns E_INDEX_BLOCKS_RELEASED if an index had to be
+   destroyed. */
+int BlockAccess::updateRecords(int relId, RecId recIds[], int numRecIds, int attrOffsets[], Attribute values[],
+                               int numValues) {
+    RelCatEntry relCatEntry;
+    int retVal = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+    if (retVal != SUCCESS) {
+        return retVal;
+    }
+
+    int numOfAttributes = relCatEntry.numAttrs;
+
+    // (the records of a block are then rewritten one after the other)
+    std::sort(recIds, recIds + numRecIds, [](const RecId &a, const RecId &b) {
+        return a.block < b.block || (a.block == b.block && a.slot < b.slot);
+    });
+
+    // the indexed attributes among those being set, with the old and new entries of
+    // the records whose value changes
+    std::vector<int> indexedAttrs;
+    std::vector<int> attrTypes;
+    for (int i = 0; i < numValues; i++) {
+        AttrCatEntry attrCatEntry;
+        AttrCacheTable::getAttrCatEntry(relId, attrOffsets[i], &attrCatEntry);
+        if (attrCatEntry.rootBlock != -1 &&
+            std::find(indexedAttrs.begin(), indexedAttrs.end(), attrOffsets[i]) == indexedAttrs.end()) {
+            indexedAttrs.push_back(attrOffsets[i]);
+            attrTypes.push_back(attrCatEntry.attrType);
+        }
+    }
+    std::vector<std::vector<Index>> oldEntries(indexedAttrs.size()), newEntries(indexedAttrs.size());
+
+    /* Rewriting the records */
+
+    Attribute record[numOfAttributes];
+    for (int i = 0; i < numRecIds; i++) {
+        RecBuffer recBlk(recIds[i].block);
+        recBlk.getRecord(record, recIds[i].slot);
+
+        for (size_t k = 0; k < indexedAttrs.size(); k++) {
+            Index entry;
+            entry.attrVal = record[indexedAttrs[k]];
+            entry.block = recIds[i].block;
+            entry.slot = recIds[i].slot;
+            memset(entry.unused, 0, sizeof(entry.unused));
+            oldEntries[k].push_back(entry);
+        }
+
+        for (int j = 0; j < numValues; j++) {
+            record[attrOffsets[j]] = values[j];
+        }
+        recBlk.setRecord(record, recIds[i].slot);
+
+        for (size_t k = 0; k < indexedAttrs.size(); k++) {
+            if (compareAttrs(oldEntries[k].back().attrVal, record[indexedAttrs[k]], attrTypes[k]) == 0) {
+                oldEntries[k].pop_back();
+                continue;
+            }
+            Index entry = oldEntries[k].back();
+            entry.attrVal = record[indexedAttrs[k]];
+            newEntries[k].push_back(entry);
+        }
+    }
+
+    /* B+ Tree Updates */
+
+    int flag = SUCCESS;
+    for (size_t k = 0; k < indexedAttrs.size(); k++) {
+        if (oldEntries[k].empty()) {
+            continue;
+        }
+
+        // the batches in key order
+        int attrType = attrTypes[k];
+        auto keyLess = [attrType](const Index &a, const Index &b) {
+            return compareAttrs(a.attrVal, b.attrVal, attrType) < 0;
+        };
+        std::stable_sort(oldEntries[k].begin(), oldEntries[k].end(), keyLess);
+        std::stable_sort(newEntries[k].begin(), newEntries[k].end(), keyLess);
+
+        int numEntries = oldEntries[k].size();
+        int ret = BPlusTree::bPlusBulkDelete(relId, indexedAttrs[k], oldEntries[k].data(), numEntries);
+        if (ret == SUCCESS) {
+            ret = insertIndexEntries(relId, indexedAttrs[k], newEntries[k].data(), numEntries,
+                                     relCatEntry.numRecs - numEntries);
+        }
+
+        if (ret == E_DISKFULL) {
+            // (index for this attribute has been destroyed)
+            flag = E_INDEX_BLOCKS_RELEASED;
+        }
+    }
+
+    return flag;
+}
+
 /*
 NOTE: This function will copy the result of the search to the `record` argument.
       The caller should ensure that space is allocated for `record` array
       based on the number of attributes in the relation.
+      The search is on the attribute at attrOffset, along an access path chosen by the caller
+      once for the whole query with chooseAccessPath(); INDEX_SCAN falls back to a linear
+      scan if the attribute has no index.
 */
-int BlockAccess::search(int relId, Attribute *record, char attrName[ATTR_SIZE], Attribute attrVal, int op) {
+int BlockAccess::search(int relId, Attribute *record, int attrOffset, Attribute attrVal, int op, int accessPath) {
     // Declare a variable called recid to store the searched record
     RecId recId;
 
-    int retVal;
-    /* get the attribute catalog entry from the attribute cache corresponding
-    to the relation with Id=relid and with attribute_name=attrName  */
     AttrCatEntry attrCatEntry;
-    retVal = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
-
-    // if this call returns an error, return the appropriate error code
+    int retVal = AttrCacheTable::getAttrCatEntry(relId, attrOffset, &attrCatEntry);
     if (retVal != SUCCESS) {
         return retVal;
     }
 
-    // get rootBlock from the attribute catalog entry
-    int rootBlk = attrCatEntry.rootBlock;
+    if (attrCatEntry.rootBlock == -1 || accessPath != INDEX_SCAN) {
+        accessPath = LINEAR_SCAN;
+    }
 
-    /* if Index does not exist for the attribute (check rootBlock == -1) */ 
-    if (rootBlk == -1) {
+    /* if Index does not exist for the attribute (or a linear scan is cheaper) */ 
+    if (accessPath == LINEAR_SCAN) {
 
         /* search for the record id (recid) corresponding to the attribute with
-           attribute name attrName, with value attrval and satisfying the
+           attribute at attrOffset, with value attrval and satisfying the
            condition op using linearSearch()
         */
-        recId = linearSearch(relId, attrName, attrVal, op);
+        recId = linearSearch(relId, attrOffset, attrVal, op);
     }
 
     /* else */ 
@@ -544,9 +980,9 @@ int BlockAccess::search(int relId, Attribute *record, char attrName[ATTR_SIZE],
         // (index exists for the attribute)
 
         /* search for the record id (recid) correspoding to the attribute with
-        attribute name attrName and with value attrval and satisfying the
+        attribute at attrOffset and with value attrval and satisfying the
         condition op using BPlusTree::bPlusSearch() */
-        recId = BPlusTree::bPlusSearch(relId, attrName, attrVal, op);
+        recId = BPlusTree::bPlusSearch(relId, attrOffset, attrVal, op);
     }
 
 
@@ -566,6 +1002,88 @@ int BlockAccess::search(int relId, Attribute *record, char attrName[ATTR_SIZE],
     return SUCCESS;
 }
 
+/* Estimates the cost, in block reads, of answering `attrName op attrVal` with the B+ tree
+   and with a linear scan, and returns the cheaper access path (INDEX_SCAN or LINEAR_SCAN).
+   The caller must reset the attribute's search index before calling this function. */
+int BlockAccess::chooseAccessPath(int relId, char attrName[ATTR_SIZE], Attribute attrVal, int op, int *indexCost,
+                                  int *linearCost) {
+    AttrCatEntry attrCatEntry;
+    int retVal = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (retVal != SUCCESS) {
+        return retVal;
+    }
+
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+
+    // a linear scan reads every record block of the relation once, however full it is
+    int numBlocks = getNumRecBlocks(relId);
+    *linearCost = numBlocks > 0 ? numBlocks : 1;
+    *indexCost = -1;
+
+    if (attrCatEntry.rootBlock == -1) {
+        return LINEAR_SCAN;
+    }
+
+    // NE cannot use the ordering of the leaves; bPlusSearch() walks every leaf and
+    // fetches nearly every record at random, which never beats a linear scan
+    if (op == NE) {
+        return LINEAR_SCAN;
+    }
+
+    // height of the B+ tree (number of internal levels above the leaves)
+    int height = 0;
+    int block = attrCatEntry.rootBlock;
+    while (StaticBuffer::getStaticBlockType(block) == IND_INTERNAL) {
+        IndInternal internalBlk(block);
+        InternalEntry intEntry;
+        internalBlk.getEntry(&intEntry, 0);
+        block = intEntry.lChild;
+        height++;
+    }
+
+    /* Estimate the number of matching records from the statistics of the attribute
+       (see Statistics::analyze()). Without statistics, count the matching leaf
+       entries, giving up once there are more matches than record blocks (an
+       index scan fetching that many records cannot beat the linear scan). */
+    int matches = 0;
+    double estimate;
+    if (Statistics::estimateMatches(relId, attrName, attrVal, op, &estimate) == SUCCESS) {
+        matches = (int)std::ceil(estimate);
+    } else {
+        AttrCacheTable::resetSearchIndex(relId, attrName);
+        while (matches < *linearCost) {
+            RecId recId = BPlusTree::bPlusSearch(relId, attrName, attrVal, op);
+            if (recId.block == -1 && recId.slot == -1) {
+                break;
+            }
+            matches++;
+        }
+        AttrCacheTable::resetSearchIndex(relId, attrName);
+    }
+
+    if (matches >= *linearCost) {
+        // (a lower bound on the index scan cost is enough to rule it out)
+        *indexCost = height + 1 + matches;
+        return LINEAR_SCAN;
+    }
+
+    // the matches are contiguous in the leaves, which splitLeaf(), buildBottomUp() and
+    // bPlusBulkDelete() all keep at least half full
+    int leafCost = 1 + matches / (IndLeaf::getMaxKeys() / 2);
+
+    // every match is a record fetch in leaf order; once the relation no longer fits
+    // in the buffer, each of them may be a disk read
+    int fetchCost = matches;
+    if (*linearCost <= BUFFER_CAPACITY && fetchCost > *linearCost) {
+        fetchCost = *linearCost;
+    }
+
+    *indexCost = height + leafCost + fetchCost;
+
+    return *indexCost < *linearCost ? INDEX_SCAN : LINEAR_SCAN;
+}
+
 /* Deletes the relation with the name specified as argument. This involves freeing the 
    record blocks and index blocks allocated to this relation, as well as deleting the 
    records corresponding to the relation in the relation catalog and attribute catalog. 
@@ -583,18 +1101,8 @@ int BlockAccess::deleteRelation(char relName[ATTR_SIZE]) {
 	}
 
 
-    /* reset the searchIndex of the relation catalog using
-       RelCacheTable::resetSearchIndex() */
-    RelCacheTable::resetSearchIndex(RELCAT_RELID);
-
-    Attribute relNameAttr; // (stores relName as type union Attribute)
-    // assign relNameAttr.sVal = relName
-    strcpy(relNameAttr.sVal, relName);
-
-    //  linearSearch on the relation catalog for RelName = relNameAttr
-    char attrName[ATTR_SIZE];
-    strcpy(attrName, RELCAT_ATTR_RELNAME);
-    RecId recId = linearSearch(RELCAT_RELID, attrName, relNameAttr, EQ);
+    //  look up the relation catalog for RelName = relName
+    RecId recId = RelCacheTable::getRelCatRecId(relName);
 
     // if the relation does not exist (linearSearch returned {-1, -1})
     //     return E_RELNOTEXIST
@@ -637,22 +1145,11 @@ int BlockAccess::deleteRelation(char relName[ATTR_SIZE]) {
         blocks corresponding to the relation with relName on its attributes
     ***/
 
-    // reset the searchIndex of the attribute catalog
-    RelCacheTable::resetSearchIndex(ATTRCAT_RELID);
-
     int numberOfAttributesDeleted = 0;
 
-    while(true) {
-        RecId attrCatRecId;
-        // attrCatRecId = linearSearch on attribute catalog for RelName = relNameAttr
-        attrCatRecId = linearSearch(ATTRCAT_RELID, attrName, relNameAttr, EQ);
-
-        // if no more attributes to iterate over (attrCatRecId == {-1, -1})
-        //     break;
-        if (attrCatRecId.block == -1 && attrCatRecId.slot == -1) {
-            break;
-        }
-
+    // for each attribute catalog entry of the relation (found using the index of
+    // the attribute catalog by relation name):
+    for (RecId attrCatRecId : AttrCacheTable::getAttrCatRecIds(relName)) {
         numberOfAttributesDeleted++;
 
         // create a RecBuffer for attrCatRecId.block
@@ -753,6 +1250,8 @@ int BlockAccess::deleteRelation(char relName[ATTR_SIZE]) {
     relCatBlock.getSlotMap(slotMap);
     slotMap[recId.slot] = SLOT_UNOCCUPIED;
     relCatBlock.setSlotMap(slotMap);
+    RelCacheTable::setRelCatRecId(relName, RecId{-1, -1});
+    AttrCacheTable::removeAttrCatRecIds(relName);
 
     /*** Updating the Relation Cache Table ***/
     /** Update relation catalog record entry (number of records in relation
@@ -10,19 +10,34 @@
 
 class BlockAccess {
  public:
-  static int search(int relId, Attribute *record, char *attrName, Attribute attrVal, int op);
+  static int search(int relId, Attribute *record, int attrOffset, Attribute attrVal, int op, int accessPath);
+
+  static int chooseAccessPath(int relId, char *attrName, Attribute attrVal, int op, int *indexCost, int *linearCost);
 
   static int insert(int relId, union Attribute *record);
 
+  static int bulkInsert(int relId, union Attribute *records, int numRecords, int *numInserted);
+
+  static int deleteRecords(int relId, RecId recIds[], int numRecIds);
+
+  static int updateRecords(int relId, RecId recIds[], int numRecIds, int attrOffsets[], Attribute values[],
+                           int numValues);
+
   static int renameRelation(char *oldName, char *newName);
 
   static int renameAttribute(char *relName, char *oldName, char *newName);
 
   static int deleteRelation(char *relName);
 
-  static RecId linearSearch(int relId, char *attrName, Attribute attrVal, int op);
+  static RecId linearSearch(int relId, int attrOffset, Attribute attrVal, int op);
 
   static int project(int relId, Attribute *record);
+
+ private:
+  static int getNewRecBlock(int relId, int numBlocks);
+  static int countNewRecBlock(int relId, int blockNum);
+  static int getNumRecBlocks(int relId);
+  static int insertIndexEntries(int relId, int attrOffset, Index entries[], int numEntries, int indexSize);
 };
 
 #endif  // NITCBASE_BLOCKACCESS_H
\ No newline at end of file
@@ -305,20 +305,14 @@ int BlockBuffer::setBlockType(int blockType) {
 	return StaticBuffer::setDirtyBit(this->blockNum);
 }
 
-int BlockBuffer::getFreeBlock(int blockType) {
-
-	// iterate through the StaticBuffer::blockAllocMap and find the block number
-	// of a free block in the disk.
-	int bufferNum = -1;
-	for (int i = 0; i < DISK_BLOCKS; i++) {
-		if (StaticBuffer::blockAllocMap[i] == UNUSED_BLK) {
-			bufferNum = i;
-			break;
-		}
-	}
+int BlockBuffer::getFreeBlock(int blockType, int goalBlock) {
+
+	// allocate a free block in the disk, at goalBlock if it is free
+	// (StaticBuffer::allocateBlock() marks it in the block allocation map)
+	int bufferNum = StaticBuffer::allocateBlock(blockType, goalBlock);
 
 	// if no block is free, return E_DISKFULL.
-	if (bufferNum == -1) {
+	if (bufferNum == E_DISKFULL) {
 		return E_DISKFULL;
 	}
 
@@ -347,18 +341,22 @@ int BlockBuffer::getFreeBlock(int blockType) {
 	return this->blockNum;
 }
 
-BlockBuffer::BlockBuffer(char blockType) {
+BlockBuffer::BlockBuffer(char blockType) : BlockBuffer(blockType, AfterBlock{-1}) {}
+
+// allocates the new block right after `after.blockNum` if that block is free
+BlockBuffer::BlockBuffer(char blockType, AfterBlock after) {
 	// allocate a block on the disk and a buffer in memory to hold the new block of
 	// given type using getFreeBlock function and get the return error codes if any.
+	int goalBlock = after.blockNum == -1 ? -1 : after.blockNum + 1;
 	int ret;
 	if (blockType == 'R') {
-		ret = getFreeBlock(REC);
+		ret = getFreeBlock(REC, goalBlock);
 	}
 	else if (blockType == 'L') {
-		ret = getFreeBlock(IND_LEAF);
+		ret = getFreeBlock(IND_LEAF, goalBlock);
 	}
 	else if (blockType == 'I') {
-		ret = getFreeBlock(IND_INTERNAL);
+		ret = getFreeBlock(IND_INTERNAL, goalBlock);
 	}
 
 	// set the blockNum field of the object to that of the allocated block
@@ -373,6 +371,8 @@ BlockBuffer::BlockBuffer(char blockType) {
 RecBuffer::RecBuffer() : BlockBuffer('R') {}
 // call parent non-default constructor with 'R' denoting record block.
 
+RecBuffer::RecBuffer(AfterBlock after) : BlockBuffer('R', after) {}
+
 /* Sets the slotmap of the block. */
 int RecBuffer::setSlotMap(unsigned char* slotMap) {
 	unsigned char* bufferPtr;
@@ -443,7 +443,7 @@ void BlockBuffer::releaseBlock() {
 		// free the block in disk by setting the data type of the entry
 		// corresponding to the block number in StaticBuffer::blockAllocMap
 		// to UNUSED_BLK.
-		StaticBuffer::blockAllocMap[this->blockNum] = UNUSED_BLK;
+		StaticBuffer::freeBlock(this->blockNum);
 
 		// set the object's blockNum to INVALID_BLOCK (-1)
 		this->blockNum = INVALID_BLOCKNUM;
@@ -453,6 +453,8 @@ void BlockBuffer::releaseBlock() {
 // call the corresponding parent constructor
 IndBuffer::IndBuffer(char blockType) : BlockBuffer(blockType){}
 
+IndBuffer::IndBuffer(char blockType, AfterBlock after) : BlockBuffer(blockType, after){}
+
 // call the corresponding parent constructor
 IndBuffer::IndBuffer(int blockNum) : BlockBuffer(blockNum){}
 
@@ -460,20 +462,37 @@ IndInternal::IndInternal() : IndBuffer('I'){}
 // call the corresponding parent constructor
 // 'I' used to denote IndInternal.
 
+IndInternal::IndInternal(AfterBlock after) : IndBuffer('I', after){}
+
 IndInternal::IndInternal(int blockNum) : IndBuffer(blockNum){}
 // call the corresponding parent constructor
 
 IndLeaf::IndLeaf() : IndBuffer('L'){} // this is the way to call parent non-default constructor.
                       // 'L' used to denote IndLeaf.
 
+IndLeaf::IndLeaf(AfterBlock after) : IndBuffer('L', after){}
+
 //this is the way to call parent non-default constructor.
 IndLeaf::IndLeaf(int blockNum) : IndBuffer(blockNum){}
 
+/* The entries of an internal index block overlap: each entry shares its rChild with the
+   lChild of the next one, so an entry takes 20 bytes after the first lChild. The count is
+   kept even so that a split leaves the same number of keys on both sides. */
+int IndInternal::getMaxKeys() {
+	return (Disk::getBlockSize() - HEADER_SIZE - LCHILD_SIZE) / (ATTR_SIZE + RCHILD_SIZE) & ~1;
+}
+
+/* Leaf index entries do not overlap. This gives an odd count for every block size, so a
+   full leaf and the new entry split evenly. */
+int IndLeaf::getMaxKeys() {
+	return (Disk::getBlockSize() - HEADER_SIZE) / LEAF_ENTRY_SIZE;
+}
+
 // Gives the indexNumth entry of the block.
 int IndInternal::getEntry(void *ptr, int indexNum) {
-    // if the indexNum is not in the valid range of [0, MAX_KEYS_INTERNAL-1]
+    // if the indexNum is not in the valid range of [0, IndInternal::getMaxKeys()-1]
     //     return E_OUTOFBOUND.
-	if (indexNum < 0 || indexNum >= MAX_KEYS_INTERNAL) {
+	if (indexNum < 0 || indexNum >= getMaxKeys()) {
 		return E_OUTOFBOUND;
 	}
 
@@ -515,9 +534,9 @@ int IndInternal::getEntry(void *ptr, int indexNum) {
 // Gives the indexNumth entry of the block.
 int IndLeaf::getEntry(void *ptr, int indexNum) {
 
-    // if the indexNum is not in the valid range of [0, MAX_KEYS_LEAF-1]
+    // if the indexNum is not in the valid range of [0, IndLeaf::getMaxKeys()-1]
     //     return E_OUTOFBOUND.
-	if (indexNum < 0 || indexNum >= MAX_KEYS_INTERNAL) {
+	if (indexNum < 0 || indexNum >= getMaxKeys()) {
 		return E_OUTOFBOUND;
 	}
 
@@ -545,9 +564,9 @@ int IndLeaf::getEntry(void *ptr, int indexNum) {
 
 /* Sets the indexNumth entry of the block with the input struct InternalEntry contents. */
 int IndInternal::setEntry(void *ptr, int indexNum) {
-    // if the indexNum is not in the valid range of [0, MAX_KEYS_INTERNAL-1]
+    // if the indexNum is not in the valid range of [0, IndInternal::getMaxKeys()-1]
     //     return E_OUTOFBOUND.
-	if (indexNum < 0 || indexNum >= MAX_KEYS_INTERNAL) {
+	if (indexNum < 0 || indexNum >= getMaxKeys()) {
 		return E_OUTOFBOUND;
 	}
 
@@ -594,9 +613,9 @@ int IndInternal::setEntry(void *ptr, int indexNum) {
 /* Sets the indexNumth entry of the block with the input struct Index contents. */
 int IndLeaf::setEntry(void *ptr, int indexNum) {
 
-    // if the indexNum is not in the valid range of [0, MAX_KEYS_INTERNAL-1]
+    // if the indexNum is not in the valid range of [0, IndLeaf::getMaxKeys()-1]
     //     return E_OUTOFBOUND.
-	if (indexNum < 0 || indexNum >= MAX_KEYS_INTERNAL) {
+	if (indexNum < 0 || indexNum >= getMaxKeys()) {
 		return E_OUTOFBOUND;
 	}
 
@@ -38,18 +38,26 @@ struct Index {
   unsigned char unused[8];
 };
 
+/* Passed to the constructor of a new block to place it right after the block `blockNum`
+   (the last block of the relation or index), so that the relation or index is
+   contiguous on the disk (see StaticBuffer::allocateBlock()). */
+struct AfterBlock {
+  int blockNum;
+};
+
 class BlockBuffer {
  protected:
   // field
   int blockNum;
   // methods
   int loadBlockAndGetBufferPtr(unsigned char **buffPtr);
-  int getFreeBlock(int blockType);
+  int getFreeBlock(int blockType, int goalBlock = -1);
   int setBlockType(int blockType);
 
  public:
   // methods
   BlockBuffer(char blockType);
+  BlockBuffer(char blockType, AfterBlock after);
   BlockBuffer(int blockNum);
   int getBlockNum();
   int getHeader(struct HeadInfo *head);
@@ -61,6 +69,7 @@ class RecBuffer : public BlockBuffer {
  public:
   // methods
   RecBuffer();
+  RecBuffer(AfterBlock after);
   RecBuffer(int blockNum);
   int getSlotMap(unsigned char *slotMap);
   int setSlotMap(unsigned char *slotMap);
@@ -72,6 +81,7 @@ class IndBuffer : public BlockBuffer {
  public:
   IndBuffer(int blockNum);
   IndBuffer(char blockType);
+  IndBuffer(char blockType, AfterBlock after);
   virtual int getEntry(void *ptr, int indexNum) = 0;
   virtual int setEntry(void *ptr, int indexNum) = 0;
 };
@@ -79,17 +89,21 @@ class IndBuffer : public BlockBuffer {
 class IndInternal : public IndBuffer {
  public:
   IndInternal();
+  IndInternal(AfterBlock after);
   IndInternal(int blockNum);
   int getEntry(void *ptr, int indexNum);
   int setEntry(void *ptr, int indexNum);
+  static int getMaxKeys();  // maximum number of keys in an internal index block of the disk
 };
 
 class IndLeaf : public IndBuffer {
  public:
   IndLeaf();
+  IndLeaf(AfterBlock after);
   IndLeaf(int blockNum);
   int getEntry(void *ptr, int indexNum);
   int setEntry(void *ptr, int indexNum);
+  static int getMaxKeys();  // maximum number of keys in a leaf index block of the disk
 };
 
 #endif  // NITCBASE_BLOCKBUFFER_H
\ No newline at end of file
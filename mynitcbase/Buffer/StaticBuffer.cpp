@@ -1,15 +1,29 @@
 #include "StaticBuffer.h"
+#include <algorithm>
+#include <cstring>
 // the declarations for this class can be found at "StaticBuffer.h"
 
-unsigned char StaticBuffer::blocks[BUFFER_CAPACITY][BLOCK_SIZE];
+unsigned char StaticBuffer::blocks[BUFFER_CAPACITY][MAX_BLOCK_SIZE];
 struct BufferMetaInfo StaticBuffer::metainfo[BUFFER_CAPACITY];
-unsigned char StaticBuffer::blockAllocMap[DISK_BLOCKS];
+std::vector<unsigned char> StaticBuffer::blockAllocMap;
+std::vector<int> StaticBuffer::extentFreeBlocks;
 
 StaticBuffer::StaticBuffer() {
 	// copy blockAllocMap blocks from disk to buffer (using readblock() of disk)
-	// blocks 0 to 3
-	for (int i = 0; i < BLOCK_ALLOCATION_MAP_SIZE; i++) {
-		Disk::readBlock(blockAllocMap + i * BLOCK_SIZE, i);
+	// (the blocks of the map are given by the superblock)
+	const SuperBlock &superBlock = Disk::getSuperBlock();
+	blockAllocMap.resize((size_t)superBlock.bmapBlocks * superBlock.blockSize);
+	for (int i = 0; i < superBlock.bmapBlocks; i++) {
+		Disk::readBlock(blockAllocMap.data() + (size_t)i * superBlock.blockSize, superBlock.bmapBlock + i);
+	}
+	blockAllocMap.resize(superBlock.numBlocks);
+
+	// count the unused blocks of each extent of the disk
+	extentFreeBlocks.assign((superBlock.numBlocks + EXTENT_BLOCKS - 1) / EXTENT_BLOCKS, 0);
+	for (int blockNum = 0; blockNum < superBlock.numBlocks; blockNum++) {
+		if (blockAllocMap[blockNum] == UNUSED_BLK) {
+			extentFreeBlocks[blockNum / EXTENT_BLOCKS]++;
+		}
 	}
 
 	for (int bufferIndex = 0; bufferIndex < BUFFER_CAPACITY; bufferIndex++) {
@@ -27,9 +41,24 @@ StaticBuffer::StaticBuffer() {
 
 // write back all modified blocks on system exit
 StaticBuffer::~StaticBuffer() {
+	flush();
+}
+
+/* Writes the block allocation map and the modified buffer blocks to the disk. The blocks
+   stay in the buffer, now clean. Used at the end of the session and at a checkpoint. */
+void StaticBuffer::flush() {
 	// copy blockAllocMap blocks from buffer to disk(using writeblock() of disk)
-	for (int i = 0; i < BLOCK_ALLOCATION_MAP_SIZE; i++) {
-		Disk::writeBlock(blockAllocMap + i * BLOCK_SIZE, i);
+	// (the runs reserved for open relations are written as unused: a checkpoint can be
+	//  followed by a crash, after which nothing would release them)
+	const SuperBlock &superBlock = Disk::getSuperBlock();
+	unsigned char bmapBlock[MAX_BLOCK_SIZE];
+	for (int i = 0; i < superBlock.bmapBlocks; i++) {
+		size_t begin = std::min((size_t)i * superBlock.blockSize, blockAllocMap.size());
+		size_t end = std::min(begin + superBlock.blockSize, blockAllocMap.size());
+		memset(bmapBlock, UNUSED_BLK, superBlock.blockSize);
+		std::replace_copy(blockAllocMap.begin() + begin, blockAllocMap.begin() + end, bmapBlock,
+			(unsigned char)RESERVED_BLK, (unsigned char)UNUSED_BLK);
+		Disk::writeBlock(bmapBlock, superBlock.bmapBlock + i);
 	}
 
 	/*iterate through all the buffer blocks,
@@ -39,17 +68,17 @@ StaticBuffer::~StaticBuffer() {
 	for (int i = 0; i < BUFFER_CAPACITY; i++) {
 		if (!metainfo[i].free && metainfo[i].dirty) {
 			Disk::writeBlock(blocks[i], metainfo[i].blockNum);
+			metainfo[i].dirty = false;
 		}
 	}
-
 }
 
 /* Assigns a buffer to the block and returns the buffer number. If no free
    buffer block is found, the least recently used (LRU) buffer block is replaced. */
 int StaticBuffer::getFreeBuffer(int blockNum) {
-	// Check if blockNum is valid (non zero and less than DISK_BLOCKS)
+	// Check if blockNum is valid (non zero and less than the number of disk blocks)
 	// and return E_OUTOFBOUND if not valid.
-	if (blockNum < 0 || blockNum >= DISK_BLOCKS) {
+	if (blockNum < 0 || blockNum >= (int)blockAllocMap.size()) {
 		return E_OUTOFBOUND;
 	}
 
@@ -103,9 +132,9 @@ int StaticBuffer::getFreeBuffer(int blockNum) {
    or E_BLOCKNOTINBUFFER otherwise
 */
 int StaticBuffer::getBufferNum(int blockNum) {
-	// Check if blockNum is valid (between zero and DISK_BLOCKS)
+	// Check if blockNum is valid (between zero and the number of disk blocks)
 	// and return E_OUTOFBOUND if not valid.
-	if (blockNum >= DISK_BLOCKS || blockNum < 0) {
+	if (blockNum >= (int)blockAllocMap.size() || blockNum < 0) {
 		return E_OUTOFBOUND;
 	}
 
@@ -153,11 +182,121 @@ int StaticBuffer::setDirtyBit(int blockNum) {
 int StaticBuffer::getStaticBlockType(int blockNum){
     // Check if blockNum is valid (non zero and less than number of disk blocks)
     // and return E_OUTOFBOUND if not valid.
-	if (blockNum >= DISK_BLOCKS || blockNum < 0) {
+	if (blockNum >= (int)blockAllocMap.size() || blockNum < 0) {
 		return E_OUTOFBOUND;
 	}
 
     // Access the entry in block allocation map corresponding to the blockNum argument
     // and return the block type after type casting to integer.
 	return (int) blockAllocMap[blockNum];
-}
\ No newline at end of file
+}
+/* Marks an unused block as a block of the given type in the block allocation map and
+   returns its block number, or E_DISKFULL if the disk is full. So that the blocks of a
+   relation or an index are contiguous on the disk, the block is chosen as
+     - the first unused block from goalBlock (the block after the last block of the
+       relation or index) to the end of its extent,
+     - else the first block of an extent with no used block,
+     - else the first unused block after goalBlock, skipping the full extents.
+   A goalBlock of -1 (a new relation or index) starts at a new extent. A goalBlock
+   preallocated by reserveBlocks() is taken as it is: it follows the last block of the
+   relation it was preallocated for, so only that relation asks for it. */
+int StaticBuffer::allocateBlock(int blockType, int goalBlock) {
+	const int numBlocks = blockAllocMap.size();
+	const int numExtents = extentFreeBlocks.size();
+	if (goalBlock < 0 || goalBlock >= numBlocks) {
+		goalBlock = -1;
+	}
+
+	int blockNum = -1;
+	if (goalBlock != -1 && blockAllocMap[goalBlock] == RESERVED_BLK) {
+		blockAllocMap[goalBlock] = blockType;
+		return goalBlock;
+	}
+
+	if (goalBlock != -1) {
+		int extentEnd = std::min(numBlocks, (goalBlock / EXTENT_BLOCKS + 1) * EXTENT_BLOCKS);
+		void *freeEntry = memchr(&blockAllocMap[goalBlock], UNUSED_BLK, extentEnd - goalBlock);
+		if (freeEntry != nullptr) {
+			blockNum = (unsigned char *)freeEntry - blockAllocMap.data();
+		}
+	}
+
+	for (int extent = 0; blockNum == -1 && extent < numExtents; extent++) {
+		int extentSize = std::min(EXTENT_BLOCKS, numBlocks - extent * EXTENT_BLOCKS);
+		if (extentFreeBlocks[extent] == extentSize) {
+			blockNum = extent * EXTENT_BLOCKS;
+		}
+	}
+
+	int firstExtent = goalBlock == -1 ? 0 : goalBlock / EXTENT_BLOCKS;
+	for (int i = 0; blockNum == -1 && i < numExtents; i++) {
+		int extent = (firstExtent + i) % numExtents;
+		if (extentFreeBlocks[extent] == 0) {
+			continue;
+		}
+		int extentStart = extent * EXTENT_BLOCKS;
+		int extentSize = std::min(EXTENT_BLOCKS, numBlocks - extentStart);
+		void *freeEntry = memchr(&blockAllocMap[extentStart], UNUSED_BLK, extentSize);
+		blockNum = (unsigned char *)freeEntry - blockAllocMap.data();
+	}
+
+	// if only preallocated blocks are left, one is taken from its relation (which is
+	// given another block when it reaches it, see BlockAccess::getNewRecBlock())
+	if (blockNum == -1 && blockType != RESERVED_BLK) {
+		void *reservedEntry = memchr(blockAllocMap.data(), RESERVED_BLK, numBlocks);
+		if (reservedEntry != nullptr) {
+			blockNum = (unsigned char *)reservedEntry - blockAllocMap.data();
+			blockAllocMap[blockNum] = blockType;
+			return blockNum;
+		}
+	}
+
+	if (blockNum == -1) {
+		return E_DISKFULL;
+	}
+
+	blockAllocMap[blockNum] = blockType;
+	extentFreeBlocks[blockNum / EXTENT_BLOCKS]--;
+	return blockNum;
+}
+
+/* Marks the block as unused in the block allocation map. */
+void StaticBuffer::freeBlock(int blockNum) {
+	if (blockAllocMap[blockNum] != UNUSED_BLK) {
+		blockAllocMap[blockNum] = UNUSED_BLK;
+		extentFreeBlocks[blockNum / EXTENT_BLOCKS]++;
+	}
+}
+
+/* Preallocates a run of at most numBlocks unused blocks for a relation, marking them
+   RESERVED_BLK so that no other relation or index is given them. The run starts at the
+   block allocateBlock() would choose for goalBlock and ends at the first used block. Returns
+   the first block of the run and stores its length in numReserved, or returns E_DISKFULL. */
+int StaticBuffer::reserveBlocks(int goalBlock, int numBlocks, int *numReserved) {
+	int reservedBlk = allocateBlock(RESERVED_BLK, goalBlock);
+	if (reservedBlk == E_DISKFULL) {
+		return E_DISKFULL;
+	}
+
+	int count = 1;
+	for (int blockNum = reservedBlk + 1; count < numBlocks && blockNum < (int)blockAllocMap.size(); blockNum++) {
+		if (blockAllocMap[blockNum] != UNUSED_BLK) {
+			break;
+		}
+		blockAllocMap[blockNum] = RESERVED_BLK;
+		extentFreeBlocks[blockNum / EXTENT_BLOCKS]--;
+		count++;
+	}
+
+	*numReserved = count;
+	return reservedBlk;
+}
+
+/* Frees the blocks of a run preallocated by reserveBlocks() that were not used. */
+void StaticBuffer::freeReservedBlocks(int reservedBlk, int numReserved) {
+	for (int blockNum = reservedBlk; blockNum < reservedBlk + numReserved; blockNum++) {
+		if (blockAllocMap[blockNum] == RESERVED_BLK) {
+			freeBlock(blockNum);
+		}
+	}
+}
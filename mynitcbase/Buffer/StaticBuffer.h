@@ -1,6 +1,8 @@
 #ifndef NITCBASE_STATICBUFFER_H
 #define NITCBASE_STATICBUFFER_H
 
+#include <vector>
+
 #include "../Disk_Class/Disk.h"
 #include "../define/constants.h"
 
@@ -16,18 +18,24 @@ class StaticBuffer {
 
  private:
   // fields
-  static unsigned char blocks[BUFFER_CAPACITY][BLOCK_SIZE];
+  static unsigned char blocks[BUFFER_CAPACITY][MAX_BLOCK_SIZE];  // first Disk::getBlockSize() bytes used
   static struct BufferMetaInfo metainfo[BUFFER_CAPACITY];
-  static unsigned char blockAllocMap[DISK_BLOCKS];
+  static std::vector<unsigned char> blockAllocMap;  // one entry per block of the disk
+  static std::vector<int> extentFreeBlocks;         // unused blocks of each extent of EXTENT_BLOCKS blocks
 
   // methods
   static int getFreeBuffer(int blockNum);
   static int getBufferNum(int blockNum);
+  static int allocateBlock(int blockType, int goalBlock);
+  static void freeBlock(int blockNum);
 
  public:
   // methods
+  static int reserveBlocks(int goalBlock, int numBlocks, int *numReserved);
+  static void freeReservedBlocks(int reservedBlk, int numReserved);
   static int getStaticBlockType(int blockNum);
   static int setDirtyBit(int blockNum);
+  static void flush();
   StaticBuffer();
   ~StaticBuffer();
 };
@@ -1,35 +1,131 @@
 #include "AttrCacheTable.h"
 
+#include <cstdlib>
 #include <cstring>
 
-AttrCacheEntry* AttrCacheTable::attrCache[MAX_OPEN];
+#include "RelCacheTable.h"
 
-/* returns the attrOffset-th attribute for the relation corresponding to relId
-NOTE: this function expects the caller to allocate memory for `*attrCatBuf`
-*/
-int AttrCacheTable::getAttrCatEntry(int relId, int attrOffset, AttrCatEntry* attrCatBuf) {
-	// check if 0 <= relId < MAX_OPEN and return E_OUTOFBOUND otherwise
-	if (relId >= MAX_OPEN || relId < 0) {
+std::vector<AttrCacheEntry*> AttrCacheTable::attrCache(MAX_OPEN, nullptr);
+std::vector<int> AttrCacheTable::numAttrs(MAX_OPEN, 0);
+std::vector<std::unordered_map<std::string, int>> AttrCacheTable::attrOffsets(MAX_OPEN);
+std::unordered_map<std::string, std::vector<RecId>> AttrCacheTable::attrCatIndex;
+
+/* Allocates the attribute cache of a relation being opened: the entries of all its
+   attributes are allocated together in one array, so that the attribute at an offset
+   is found by indexing and the attributes of a relation are contiguous in memory. */
+void AttrCacheTable::createAttrCache(int relId, int numAttrs) {
+	attrCache[relId] = (AttrCacheEntry*)calloc(numAttrs, sizeof(AttrCacheEntry));
+	AttrCacheTable::numAttrs[relId] = numAttrs;
+	attrOffsets[relId].clear();
+}
+
+/* Stores the entry of an attribute in the attribute cache of the relation (at the
+   offset of the attribute) and indexes it by name. */
+void AttrCacheTable::addAttrCacheEntry(int relId, AttrCacheEntry* attrCacheEntry) {
+	int attrOffset = attrCacheEntry->attrCatEntry.offset;
+	attrCache[relId][attrOffset] = *attrCacheEntry;
+	attrOffsets[relId][attrCacheEntry->attrCatEntry.attrName] = attrOffset;
+}
+
+/* Frees the attribute cache of a relation being closed. */
+void AttrCacheTable::freeAttrCache(int relId) {
+	free(attrCache[relId]);
+	attrCache[relId] = nullptr;
+	numAttrs[relId] = 0;
+	attrOffsets[relId].clear();
+}
+
+/* Loads the attribute cache of an open relation on its first use, reading the records
+   of its attributes from the Attribute Catalog in one pass over their rec-ids (see
+   getAttrCatRecIds()). Opening a relation thus only reads its Relation Catalog record. */
+int AttrCacheTable::loadAttrCache(int relId) {
+	RelCatEntry relCatEntry;
+	int ret = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+	if (ret != SUCCESS) {
+		return ret;
+	}
+
+	// allocate the entries of all the attributes of the relation at once
+	createAttrCache(relId, relCatEntry.numAttrs);
+
+	for (RecId attrCatRecId : getAttrCatRecIds(relCatEntry.relName)) {
+		RecBuffer attrCatBlock(attrCatRecId.block);
+		Attribute record[ATTRCAT_NO_ATTRS];
+		attrCatBlock.getRecord(record, attrCatRecId.slot);
+
+		AttrCacheEntry attrCacheEntry;
+		recordToAttrCatEntry(record, &attrCacheEntry.attrCatEntry);
+		attrCacheEntry.recId = attrCatRecId;
+		attrCacheEntry.dirty = false;
+		attrCacheEntry.searchIndex = {-1, -1};
+		addAttrCacheEntry(relId, &attrCacheEntry);
+	}
+
+	return SUCCESS;
+}
+
+/* Sets *attrCacheEntry to the entry of the attrOffset-th attribute of the relation. */
+int AttrCacheTable::getAttrCacheEntry(int relId, int attrOffset, AttrCacheEntry** attrCacheEntry) {
+	// check if relId is within the Open Relation Table and return E_OUTOFBOUND otherwise
+	if (relId >= (int)attrCache.size() || relId < 0) {
 		return E_OUTOFBOUND;
 	}
 
-	// check if attrCache[relId] == nullptr and return E_RELNOTOPEN if true
+	// load the attribute cache if it is not loaded yet (E_RELNOTOPEN if the
+	// relation is not open)
 	if (attrCache[relId] == nullptr) {
-		return E_RELNOTOPEN;
+		int ret = loadAttrCache(relId);
+		if (ret != SUCCESS) {
+			return ret;
+		}
+	}
+
+	// there is no attribute at this offset
+	if (attrOffset < 0 || attrOffset >= numAttrs[relId]) {
+		return E_ATTRNOTEXIST;
 	}
 
-	// traverse the linked list of attribute cache entries
-	for (AttrCacheEntry* entry = attrCache[relId]; entry != nullptr; entry = entry->next) {
-		if (entry->attrCatEntry.offset == attrOffset) {
+	*attrCacheEntry = &attrCache[relId][attrOffset];
+	return SUCCESS;
+}
+
+/* Sets *attrCacheEntry to the entry of the attribute with name `attrName` of the relation. */
+int AttrCacheTable::getAttrCacheEntry(int relId, char attrName[ATTR_SIZE], AttrCacheEntry** attrCacheEntry) {
+	// check that relId is valid and corresponds to an open relation
+	if (relId >= (int)attrCache.size() || relId < 0) {
+		return E_OUTOFBOUND;
+	}
 
-			// copy entry->attrCatEntry to *attrCatBuf and return SUCCESS;
-			*attrCatBuf = entry->attrCatEntry;
-			return SUCCESS;
+	if (attrCache[relId] == nullptr) {
+		int ret = loadAttrCache(relId);
+		if (ret != SUCCESS) {
+			return ret;
 		}
 	}
 
-	// there is no attribute at this offset
-	return E_ATTRNOTEXIST;
+	// no attribute with name attrName for the relation
+	auto offset = attrOffsets[relId].find(attrName);
+	if (offset == attrOffsets[relId].end()) {
+		return E_ATTRNOTEXIST;
+	}
+
+	*attrCacheEntry = &attrCache[relId][offset->second];
+	return SUCCESS;
+}
+
+/* returns the attrOffset-th attribute for the relation corresponding to relId
+NOTE: this function expects the caller to allocate memory for `*attrCatBuf`
+*/
+int AttrCacheTable::getAttrCatEntry(int relId, int attrOffset, AttrCatEntry* attrCatBuf) {
+	AttrCacheEntry* entry;
+	int ret = getAttrCacheEntry(relId, attrOffset, &entry);
+	if (ret != SUCCESS) {
+		return ret;
+	}
+
+	// copy entry->attrCatEntry to *attrCatBuf and return SUCCESS;
+	*attrCatBuf = entry->attrCatEntry;
+	return SUCCESS;
 }
 
 /* Converts a attribute catalog record to AttrCatEntry struct
@@ -51,154 +147,63 @@ void AttrCacheTable::recordToAttrCatEntry(union Attribute record[ATTRCAT_NO_ATTR
 NOTE: this function expects the caller to allocate memory for `*attrCatBuf`
 */
 int AttrCacheTable::getAttrCatEntry(int relId, char attrName[ATTR_SIZE], AttrCatEntry* attrCatBuf) {
-
-	// check that relId is valid and corresponds to an open relation
-	if (relId >= MAX_OPEN || relId < 0) {
-		return E_OUTOFBOUND;
-	}
-
-	if (attrCache[relId] == nullptr) {
-		return E_RELNOTOPEN;
-	}
-
-	// iterate over the entries in the attribute cache and set attrCatBuf to the entry that
-	//    matches attrName
-	AttrCacheEntry* entry = attrCache[relId];
-	while (entry) {
-		// compare the entry attrName with given attrName
-		if (strcmp(entry->attrCatEntry.attrName, attrName) == 0) {
-
-			// copy the content to buffer
-			*attrCatBuf = entry->attrCatEntry;
-
-			return SUCCESS;
-		}
-
-		entry = entry->next;
+	AttrCacheEntry* entry;
+	int ret = getAttrCacheEntry(relId, attrName, &entry);
+	if (ret != SUCCESS) {
+		return ret;
 	}
 
-	// no attribute with name attrName for the relation
-	return E_ATTRNOTEXIST;
+	// copy the content to buffer
+	*attrCatBuf = entry->attrCatEntry;
+	return SUCCESS;
 }
 
 int AttrCacheTable::getSearchIndex(int relId, char attrName[ATTR_SIZE], IndexId* searchIndex) {
-
-	/*if relId is outside the range [0, MAX_OPEN-1]*/
-	if (relId < 0 || relId >= MAX_OPEN) {
-		return E_OUTOFBOUND;
-	}
-
-	/*if entry corresponding to the relId in the Attribute Cache Table is free*/
-	if (attrCache[relId] == nullptr) {
-		return E_RELNOTOPEN;
-	}
-
-	/*for each attribute corresponding to relation with relId */
-	for (AttrCacheEntry* cacheEntry = attrCache[relId]; cacheEntry != nullptr; cacheEntry = cacheEntry->next) {
-
-		/* if attrName/offset field of the AttrCatEntry
-			is equal to the input attrName/attrOffset */
-		if (strcmp(attrName, cacheEntry->attrCatEntry.attrName) == 0) {
-
-			//copy the searchIndex field of the corresponding Attribute Cache entry
-			//in the Attribute Cache Table to input searchIndex variable.
-			*searchIndex = cacheEntry->searchIndex;
-
-			return SUCCESS;
-		}
+	AttrCacheEntry* entry;
+	int ret = getAttrCacheEntry(relId, attrName, &entry);
+	if (ret != SUCCESS) {
+		return ret;
 	}
 
-	return E_ATTRNOTEXIST;
+	//copy the searchIndex field of the corresponding Attribute Cache entry
+	//in the Attribute Cache Table to input searchIndex variable.
+	*searchIndex = entry->searchIndex;
+	return SUCCESS;
 }
 
 int AttrCacheTable::getSearchIndex(int relId, int attrOffset, IndexId* searchIndex) {
-
-	/*if relId is outside the range [0, MAX_OPEN-1]*/
-	if (relId < 0 || relId >= MAX_OPEN) {
-		return E_OUTOFBOUND;
-	}
-
-	/*if entry corresponding to the relId in the Attribute Cache Table is free*/
-	if (attrCache[relId] == nullptr) {
-		return E_RELNOTOPEN;
-	}
-
-	/*for each attribute corresponding to relation with relId */
-	for (AttrCacheEntry* cacheEntry = attrCache[relId]; cacheEntry != nullptr; cacheEntry = cacheEntry->next) {
-
-		/* if attrName/offset field of the AttrCatEntry
-			is equal to the input attrName/attrOffset */
-		if (attrOffset == cacheEntry->attrCatEntry.offset) {
-
-			//copy the searchIndex field of the corresponding Attribute Cache entry
-			//in the Attribute Cache Table to input searchIndex variable.
-			*searchIndex = cacheEntry->searchIndex;
-
-			return SUCCESS;
-		}
+	AttrCacheEntry* entry;
+	int ret = getAttrCacheEntry(relId, attrOffset, &entry);
+	if (ret != SUCCESS) {
+		return ret;
 	}
 
-	return E_ATTRNOTEXIST;
+	*searchIndex = entry->searchIndex;
+	return SUCCESS;
 }
 
 int AttrCacheTable::setSearchIndex(int relId, char attrName[ATTR_SIZE], IndexId* searchIndex) {
-
-	/*if relId is outside the range [0, MAX_OPEN-1]*/
-	if (relId < 0 || relId >= MAX_OPEN) {
-		return E_OUTOFBOUND;
-	}
-
-	/*entry corresponding to the relId in the Attribute Cache Table is free*/
-	if (attrCache[relId] == nullptr) {
-		return E_RELNOTOPEN;
+	AttrCacheEntry* entry;
+	int ret = getAttrCacheEntry(relId, attrName, &entry);
+	if (ret != SUCCESS) {
+		return ret;
 	}
 
-	/* each attribute corresponding to relation with relId */
-	for (AttrCacheEntry* cacheEntry = attrCache[relId]; cacheEntry != nullptr; cacheEntry = cacheEntry->next) {
-
-		/* attrName/offset field of the AttrCatEntry
-		is equal to the input attrName/attrOffset */
-		if (strcmp(attrName, cacheEntry->attrCatEntry.attrName) == 0) {
-
-			// copy the input searchIndex variable to the searchIndex field of the
-			//corresponding Attribute Cache entry in the Attribute Cache Table.
-			cacheEntry->searchIndex = *searchIndex;
-
-			return SUCCESS;
-		}
-	}
-
-	return E_ATTRNOTEXIST;
+	// copy the input searchIndex variable to the searchIndex field of the
+	//corresponding Attribute Cache entry in the Attribute Cache Table.
+	entry->searchIndex = *searchIndex;
+	return SUCCESS;
 }
 
 int AttrCacheTable::setSearchIndex(int relId, int attrOffset, IndexId* searchIndex) {
-
-	/*if relId is outside the range [0, MAX_OPEN-1]*/
-	if (relId < 0 || relId >= MAX_OPEN) {
-		return E_OUTOFBOUND;
-	}
-
-	/*entry corresponding to the relId in the Attribute Cache Table is free*/
-	if (attrCache[relId] == nullptr) {
-		return E_RELNOTOPEN;
-	}
-
-	/* each attribute corresponding to relation with relId */
-	for (AttrCacheEntry* cacheEntry = attrCache[relId]; cacheEntry != nullptr; cacheEntry = cacheEntry->next) {
-
-		/* attrName/offset field of the AttrCatEntry
-		is equal to the input attrName/attrOffset */
-		if (attrOffset == cacheEntry->attrCatEntry.offset) {
-
-			// copy the input searchIndex variable to the searchIndex field of the
-			//corresponding Attribute Cache entry in the Attribute Cache Table.
-			cacheEntry->searchIndex = *searchIndex;
-
-			return SUCCESS;
-		}
+	AttrCacheEntry* entry;
+	int ret = getAttrCacheEntry(relId, attrOffset, &entry);
+	if (ret != SUCCESS) {
+		return ret;
 	}
 
-	return E_ATTRNOTEXIST;
+	entry->searchIndex = *searchIndex;
+	return SUCCESS;
 }
 
 int AttrCacheTable::resetSearchIndex(int relId, char attrName[ATTR_SIZE]) {
@@ -221,68 +226,38 @@ int AttrCacheTable::resetSearchIndex(int relId, int attrOffset) {
 
 // Sets the Attribute Catalog entry corresponding to the given attribute of the specified relation in the Attribute Cache Table.
 int AttrCacheTable::setAttrCatEntry(int relId, char attrName[ATTR_SIZE], AttrCatEntry* attrCatBuf) {
-
-	/*relId is outside the range [0, MAX_OPEN-1]*/
-	if (relId < 0 || relId >= MAX_OPEN) {
-		return E_OUTOFBOUND;
-	}
-
-	/*entry corresponding to the relId in the Attribute Cache Table is free*/
-	if (attrCache[relId] == nullptr) {
-		return E_RELNOTOPEN;
-	}
-
-	/* each attribute corresponding to relation with relId */
-	for (AttrCacheEntry* entry = attrCache[relId]; entry != nullptr; entry = entry->next) {
-		/* the attrName field of the AttrCatEntry
-		   is equal to the input attrName */
-		if (strcmp(entry->attrCatEntry.attrName, attrName) == 0) {
-			// copy the attrCatBuf to the corresponding Attribute Catalog entry in
-			// the Attribute Cache Table.
-			entry->attrCatEntry = *attrCatBuf;
-
-			// set the dirty flag of the corresponding Attribute Cache entry in the
-			// Attribute Cache Table.
-			entry->dirty = true;
-
-			return SUCCESS;
-		}
+	AttrCacheEntry* entry;
+	int ret = getAttrCacheEntry(relId, attrName, &entry);
+	if (ret != SUCCESS) {
+		return ret;
 	}
 
-	return E_ATTRNOTEXIST;
+	return setAttrCatEntry(relId, entry->attrCatEntry.offset, attrCatBuf);
 }
 
 // Sets the Attribute Catalog entry corresponding to the given attribute of the specified relation in the Attribute Cache Table.
 int AttrCacheTable::setAttrCatEntry(int relId, int attrOffset, AttrCatEntry* attrCatBuf) {
-
-	/*relId is outside the range [0, MAX_OPEN-1]*/
-	if (relId < 0 || relId >= MAX_OPEN) {
-		return E_OUTOFBOUND;
+	AttrCacheEntry* entry;
+	int ret = getAttrCacheEntry(relId, attrOffset, &entry);
+	if (ret != SUCCESS) {
+		return ret;
 	}
 
-	/*entry corresponding to the relId in the Attribute Cache Table is free*/
-	if (attrCache[relId] == nullptr) {
-		return E_RELNOTOPEN;
+	// keep the index by name up to date if the attribute is renamed
+	if (strcmp(entry->attrCatEntry.attrName, attrCatBuf->attrName) != 0) {
+		attrOffsets[relId].erase(entry->attrCatEntry.attrName);
+		attrOffsets[relId][attrCatBuf->attrName] = attrOffset;
 	}
 
-	/* each attribute corresponding to relation with relId */
-	for (AttrCacheEntry* entry = attrCache[relId]; entry != nullptr; entry = entry->next) {
-		/* the offset field of the AttrCatEntry
-		   is equal to the input attroffset */
-		if (entry->attrCatEntry.offset == attrOffset) {
-			// copy the attrCatBuf to the corresponding Attribute Catalog entry in
-			// the Attribute Cache Table.
-			entry->attrCatEntry = *attrCatBuf;
+	// copy the attrCatBuf to the corresponding Attribute Catalog entry in
+	// the Attribute Cache Table.
+	entry->attrCatEntry = *attrCatBuf;
 
-			// set the dirty flag of the corresponding Attribute Cache entry in the
-			// Attribute Cache Table.
-			entry->dirty = true;
-
-			return SUCCESS;
-		}
-	}
+	// set the dirty flag of the corresponding Attribute Cache entry in the
+	// Attribute Cache Table.
+	entry->dirty = true;
 
-	return E_ATTRNOTEXIST;
+	return SUCCESS;
 }
 
 /* A function that converts AttrCatEntry structure to a record, implemented as an array of union Attribute. */
@@ -295,4 +270,64 @@ void AttrCacheTable::attrCatEntryToRecord(AttrCatEntry* attrCatEntry, union Attr
 	record[RELCAT_FIRST_BLOCK_INDEX].nVal = (double)attrCatEntry->primaryFlag;
 	record[RELCAT_LAST_BLOCK_INDEX].nVal = (double)attrCatEntry->rootBlock;
 	record[RELCAT_NO_SLOTS_PER_BLOCK_INDEX].nVal = (double)attrCatEntry->offset;
-}
\ No newline at end of file
+}
+/* Returns the rec-ids of the records of the attributes of the relation `relName` in
+   the Attribute Catalog, in the order they are stored in the catalog (empty if there
+   is no such relation). Replaces a linear search of the Attribute Catalog on the
+   relation name. */
+std::vector<RecId> AttrCacheTable::getAttrCatRecIds(const char relName[ATTR_SIZE]) {
+	auto entry = attrCatIndex.find(relName);
+	if (entry == attrCatIndex.end()) {
+		return std::vector<RecId>();
+	}
+	return entry->second;
+}
+
+/* Records that a record of an attribute of the relation `relName` has been inserted
+   at `recId` in the Attribute Catalog. */
+void AttrCacheTable::addAttrCatRecId(const char relName[ATTR_SIZE], RecId recId) {
+	attrCatIndex[relName].push_back(recId);
+}
+
+/* Moves the attributes of the relation `oldRelName` to `newRelName`, once their
+   records in the Attribute Catalog have been renamed. */
+void AttrCacheTable::renameAttrCatRecIds(const char oldRelName[ATTR_SIZE], const char newRelName[ATTR_SIZE]) {
+	auto entry = attrCatIndex.find(oldRelName);
+	if (entry == attrCatIndex.end()) {
+		return;
+	}
+	std::vector<RecId> recIds = std::move(entry->second);
+	attrCatIndex.erase(entry);
+	attrCatIndex[newRelName] = std::move(recIds);
+}
+
+/* Forgets the attributes of the relation `relName`, once their records have been
+   deleted from the Attribute Catalog. */
+void AttrCacheTable::removeAttrCatRecIds(const char relName[ATTR_SIZE]) {
+	attrCatIndex.erase(relName);
+}
+
+/* Loads the rec-id of every record of the Attribute Catalog into attrCatIndex, by the
+   name of the relation of the attribute. */
+void AttrCacheTable::buildAttrCatIndex() {
+	attrCatIndex.clear();
+
+	for (int block = ATTRCAT_BLOCK; block != -1;) {
+		RecBuffer attrCatBlock(block);
+		HeadInfo head;
+		attrCatBlock.getHeader(&head);
+
+		unsigned char slotMap[head.numSlots];
+		attrCatBlock.getSlotMap(slotMap);
+
+		for (int slot = 0; slot < head.numSlots; slot++) {
+			if (slotMap[slot] == SLOT_OCCUPIED) {
+				Attribute record[ATTRCAT_NO_ATTRS];
+				attrCatBlock.getRecord(record, slot);
+				attrCatIndex[record[ATTRCAT_REL_NAME_INDEX].sVal].push_back(RecId{block, slot});
+			}
+		}
+
+		block = head.rblock;
+	}
+}
@@ -1,6 +1,10 @@
 #ifndef NITCBASE_ATTRCACHETABLE_H
 #define NITCBASE_ATTRCACHETABLE_H
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "../Buffer/BlockBuffer.h"
 #include "../define/constants.h"
 #include "../define/id.h"
@@ -20,7 +24,6 @@ typedef struct AttrCacheEntry {
   bool dirty;
   RecId recId;
   IndexId searchIndex;
-  struct AttrCacheEntry *next;
 
 } AttrCacheEntry;
 
@@ -39,12 +42,26 @@ class AttrCacheTable {
   static int setSearchIndex(int relId, int attrOffset, IndexId *searchIndex);
   static int resetSearchIndex(int relId, char attrName[ATTR_SIZE]);
   static int resetSearchIndex(int relId, int attrOffset);
+  static std::vector<RecId> getAttrCatRecIds(const char relName[ATTR_SIZE]);
+  static void addAttrCatRecId(const char relName[ATTR_SIZE], RecId recId);
+  static void renameAttrCatRecIds(const char oldRelName[ATTR_SIZE], const char newRelName[ATTR_SIZE]);
+  static void removeAttrCatRecIds(const char relName[ATTR_SIZE]);
 
  private:
   // field
-  static AttrCacheEntry *attrCache[MAX_OPEN];
+  static std::vector<AttrCacheEntry *> attrCache;  // attributes of each open relation, in one array indexed by offset
+  static std::vector<int> numAttrs;
+  static std::vector<std::unordered_map<std::string, int>> attrOffsets;  // offset of each attribute, by name
+  static std::unordered_map<std::string, std::vector<RecId>> attrCatIndex;  // rec-ids of the Attribute Catalog records of each relation
 
   // methods
+  static void createAttrCache(int relId, int numAttrs);
+  static void addAttrCacheEntry(int relId, AttrCacheEntry *attrCacheEntry);
+  static void freeAttrCache(int relId);
+  static int loadAttrCache(int relId);
+  static void buildAttrCatIndex();
+  static int getAttrCacheEntry(int relId, int attrOffset, AttrCacheEntry **attrCacheEntry);
+  static int getAttrCacheEntry(int relId, char attrName[ATTR_SIZE], AttrCacheEntry **attrCacheEntry);
   static void recordToAttrCatEntry(union Attribute record[ATTRCAT_NO_ATTRS], AttrCatEntry *attrCatEntry);
   static void attrCatEntryToRecord(AttrCatEntry *attrCatEntry, union Attribute record[ATTRCAT_NO_ATTRS]);
 };
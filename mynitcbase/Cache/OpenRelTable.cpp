@@ -3,7 +3,10 @@
 #include <cstring>
 #include <cstdlib>
 
-OpenRelTableMetaInfo OpenRelTable::tableMetaInfo[MAX_OPEN];
+std::vector<OpenRelTableMetaInfo> OpenRelTable::tableMetaInfo(MAX_OPEN);
+std::unordered_map<std::string, int> OpenRelTable::relIds;
+std::unordered_set<std::string> OpenRelTable::evictedRels;
+int OpenRelTable::useClock = 0;
 
 /*
   * Initializes the meta information of each entry of
@@ -15,10 +18,12 @@ OpenRelTableMetaInfo OpenRelTable::tableMetaInfo[MAX_OPEN];
 OpenRelTable::OpenRelTable() {
 
 	// initialize relCache and attrCache with nullptr
-	for (int i = 0; i < MAX_OPEN; ++i) {
+	for (int i = 0; i < (int)tableMetaInfo.size(); ++i) {
 		RelCacheTable::relCache[i] = nullptr;
 		AttrCacheTable::attrCache[i] = nullptr;
 		tableMetaInfo[i].free = true;
+		tableMetaInfo[i].refCount = 0;
+		tableMetaInfo[i].lastUsed = 0;
 	}
 
 	/************ Setting up Relation Cache entries ************/
@@ -35,6 +40,11 @@ OpenRelTable::OpenRelTable() {
 	RelCacheTable::recordToRelCatEntry(relCatRecord, &relCacheEntry.relCatEntry);
 	relCacheEntry.recId.block = RELCAT_BLOCK;
 	relCacheEntry.recId.slot = RELCAT_SLOTNUM_FOR_RELCAT;
+	relCacheEntry.dirty = false;
+	relCacheEntry.reservedBlk = -1;
+	relCacheEntry.numReserved = 0;
+	relCacheEntry.freeSlotBlk = relCacheEntry.relCatEntry.firstBlk;
+	relCacheEntry.numBlocks = relCacheEntry.relCatEntry.firstBlk == -1 ? 0 : -1;
 
 	// allocate this on the heap because we want it to persist outside this function
 	RelCacheTable::relCache[RELCAT_RELID] = (struct RelCacheEntry*)malloc(sizeof(RelCacheEntry));
@@ -50,6 +60,8 @@ OpenRelTable::OpenRelTable() {
 	RelCacheTable::recordToRelCatEntry(relCatRecord, &relCacheEntry.relCatEntry);
 	relCacheEntry.recId.block = RELCAT_BLOCK;
 	relCacheEntry.recId.slot = RELCAT_SLOTNUM_FOR_ATTRCAT;
+	relCacheEntry.freeSlotBlk = relCacheEntry.relCatEntry.firstBlk;
+	relCacheEntry.numBlocks = relCacheEntry.relCatEntry.firstBlk == -1 ? 0 : -1;
 
 	RelCacheTable::relCache[ATTRCAT_RELID] = (struct RelCacheEntry*)malloc(sizeof(RelCacheEntry));
 	*(RelCacheTable::relCache[ATTRCAT_RELID]) = relCacheEntry;
@@ -63,57 +75,35 @@ OpenRelTable::OpenRelTable() {
 
 	Attribute attrCatRecord[ATTRCAT_NO_ATTRS];
 
-	// iterate through all the attributes of the relation catalog and create a linked
-	// list of AttrCacheEntry (slots 0 to 5)
-	// for each of the entries, set
+	// iterate through all the attributes of the relation catalog and add an
+	// AttrCacheEntry for each (slots 0 to 5), setting
 	//    attrCacheEntry.recId.block = ATTRCAT_BLOCK;
 	//    attrCacheEntry.recId.slot = i   (0 to 5)
-	//    and attrCacheEntry.next appropriately
-	// NOTE: allocate each entry dynamically using malloc
-	AttrCacheEntry* head, * curr;
-	head = curr = (AttrCacheEntry*)malloc(sizeof(AttrCacheEntry));
+	AttrCacheEntry attrCacheEntry;
+	attrCacheEntry.dirty = false;
+	attrCacheEntry.searchIndex = {-1, -1};
+	attrCacheEntry.recId.block = ATTRCAT_BLOCK;
+
+	AttrCacheTable::createAttrCache(RELCAT_RELID, RELCAT_NO_ATTRS);
 	int i;
-	for (i = 0; i < RELCAT_NO_ATTRS - 1; i++) {
+	for (i = 0; i < RELCAT_NO_ATTRS; i++) {
 		attrCatBlock.getRecord(attrCatRecord, i);
-		AttrCacheTable::recordToAttrCatEntry(attrCatRecord, &curr->attrCatEntry);
-		curr->recId.slot = i;
-		curr->recId.block = ATTRCAT_BLOCK;
-		curr->next = (AttrCacheEntry*)malloc(sizeof(AttrCacheEntry));
-		curr = curr->next;
+		AttrCacheTable::recordToAttrCatEntry(attrCatRecord, &attrCacheEntry.attrCatEntry);
+		attrCacheEntry.recId.slot = i;
+		AttrCacheTable::addAttrCacheEntry(RELCAT_RELID, &attrCacheEntry);
 	}
-	attrCatBlock.getRecord(attrCatRecord, i);
-	AttrCacheTable::recordToAttrCatEntry(attrCatRecord, &curr->attrCatEntry);
-	curr->next = nullptr;
-	curr->recId.slot = i;
-	curr->recId.block = ATTRCAT_BLOCK;
-	i++;
-
-	// set the next field in the last entry to nullptr
-
-	AttrCacheTable::attrCache[RELCAT_RELID] = head;
 
 	/**** setting up Attribute Catalog relation in the Attribute Cache Table ****/
 
 	// set up the attributes of the attribute cache similarly.
 	// read slots 6-11 from attrCatBlock and initialise recId appropriately
-	head = curr = (AttrCacheEntry*)malloc(sizeof(AttrCacheEntry));
-	for (; i < RELCAT_NO_ATTRS + ATTRCAT_NO_ATTRS - 1; i++) {
+	AttrCacheTable::createAttrCache(ATTRCAT_RELID, ATTRCAT_NO_ATTRS);
+	for (; i < RELCAT_NO_ATTRS + ATTRCAT_NO_ATTRS; i++) {
 		attrCatBlock.getRecord(attrCatRecord, i);
-		AttrCacheTable::recordToAttrCatEntry(attrCatRecord, &curr->attrCatEntry);
-		curr->recId.slot = i;
-		curr->recId.block = ATTRCAT_BLOCK;
-		curr->next = (AttrCacheEntry*)malloc(sizeof(AttrCacheEntry));
-		curr = curr->next;
+		AttrCacheTable::recordToAttrCatEntry(attrCatRecord, &attrCacheEntry.attrCatEntry);
+		attrCacheEntry.recId.slot = i;
+		AttrCacheTable::addAttrCacheEntry(ATTRCAT_RELID, &attrCacheEntry);
 	}
-	attrCatBlock.getRecord(attrCatRecord, i);
-	AttrCacheTable::recordToAttrCatEntry(attrCatRecord, &curr->attrCatEntry);
-	curr->next = nullptr;
-	curr->recId.slot = i;
-	curr->recId.block = ATTRCAT_BLOCK;
-	i++;
-
-	// set the value at AttrCacheTable::attrCache[ATTRCAT_RELID]
-	AttrCacheTable::attrCache[ATTRCAT_RELID] = head;
 
 	/************ Setting up tableMetaInfo entries ************/
 
@@ -128,49 +118,111 @@ OpenRelTable::OpenRelTable() {
 	// for attrcat relid
 	tableMetaInfo[ATTRCAT_RELID].free = false;
 	strcpy(tableMetaInfo[ATTRCAT_RELID].relName, ATTRCAT_RELNAME);
+
+	relIds.clear();
+	evictedRels.clear();
+	relIds[RELCAT_RELNAME] = RELCAT_RELID;
+	relIds[ATTRCAT_RELNAME] = ATTRCAT_RELID;
+
+	// index the Relation Catalog and the Attribute Catalog by relation name, so
+	// that relations and their attributes are found without searching them
+	RelCacheTable::buildRelCatIndex();
+	AttrCacheTable::buildAttrCatIndex();
 }
 
-/* Returns `index` of an unoccupied entry in the Open Relation Table. */
+/* Returns `index` of an unoccupied entry in the Open Relation Table. When there is
+   none, the least recently used relation not in use by the current command is evicted
+   (it stays open and is loaded again by pinRel()), and when every relation is in
+   use the table grows by one entry. */
 int OpenRelTable::getFreeOpenRelTableEntry() {
 
 	/* traverse through the tableMetaInfo array,
 	  find a free entry in the Open Relation Table.*/
-	for (int i = ATTRCAT_RELID + 1; i < MAX_OPEN; i++) {
+	int victim = -1;
+	for (int i = ATTRCAT_RELID + 1; i < (int)tableMetaInfo.size(); i++) {
 		if (tableMetaInfo[i].free == true)
 		{
 			return i;
 		}
 
+		if (tableMetaInfo[i].refCount == 0 &&
+		    (victim == -1 || tableMetaInfo[i].lastUsed < tableMetaInfo[victim].lastUsed)) {
+			victim = i;
+		}
+	}
+
+	// evict the victim, writing back its modified cache entries
+	if (victim != -1) {
+		std::string relName = tableMetaInfo[victim].relName;
+		closeRel(victim);
+		evictedRels.insert(relName);
+		return victim;
 	}
 
-	// if found return the relation id, else return E_CACHEFULL.
-	return E_CACHEFULL;
+	// every open relation is in use: add an entry to the Open Relation Table
+	int relId = tableMetaInfo.size();
+	OpenRelTableMetaInfo metaInfo;
+	metaInfo.free = true;
+	metaInfo.refCount = 0;
+	metaInfo.lastUsed = 0;
+	tableMetaInfo.push_back(metaInfo);
+	RelCacheTable::relCache.push_back(nullptr);
+	AttrCacheTable::attrCache.push_back(nullptr);
+	AttrCacheTable::numAttrs.push_back(0);
+	AttrCacheTable::attrOffsets.emplace_back();
+
+	return relId;
 }
 
-/* Returns the relation id, that is, the index, of the entry
-corresponding to the input relation in the Open Relation Table. */
-int OpenRelTable::getRelId(char relName[ATTR_SIZE]) {
+/* Marks the relation as used by the current command, so that it is not evicted
+   before the command ends. */
+void OpenRelTable::useRelId(int relId) {
+	tableMetaInfo[relId].refCount++;
+	tableMetaInfo[relId].lastUsed = ++useClock;
+}
 
-	/* traverse through the tableMetaInfo array,
-	  find the entry in the Open Relation Table corresponding to relName.*/
-	for (int i = 0; i < MAX_OPEN; i++)
-	{
-		if (!tableMetaInfo[i].free && strcmp(tableMetaInfo[i].relName, relName) == 0) {
-			return i;
-		}
+/* Releases the rel-ids handed out during a command, once the command has ended. */
+void OpenRelTable::releaseRelIds() {
+	for (int i = 0; i < (int)tableMetaInfo.size(); i++) {
+		tableMetaInfo[i].refCount = 0;
 	}
+}
+
+/* Returns whether the relation is open, whether or not its cache entries
+are loaded. The Open Relation Table is not changed. */
+bool OpenRelTable::isOpen(char relName[ATTR_SIZE]) {
+	return relIds.count(relName) > 0 || evictedRels.count(relName) > 0;
+}
+
+/* Returns the relation id, that is, the index, of the entry
+corresponding to the input relation in the Open Relation Table, or E_RELNOTOPEN.
+An open relation whose cache entries were evicted is loaded again. The relation
+is pinned until the end of the current command (see releaseRelIds()). */
+int OpenRelTable::pinRel(char relName[ATTR_SIZE]) {
+
+	/* look up the entry in the Open Relation Table corresponding to relName
+	   (relIds maps the name of each open relation to its entry) */
+	auto entry = relIds.find(relName);
 
 	// if found return the relation id, else indicate that the relation do not
 	// have an entry in the Open Relation Table.
-	return E_RELNOTOPEN;
+	if (entry == relIds.end()) {
+		// an open relation evicted from the cache is loaded again
+		if (evictedRels.erase(relName) == 0) {
+			return E_RELNOTOPEN;
+		}
+		return openRel(relName);
+	}
+	useRelId(entry->second);
+	return entry->second;
 }
 
 
 int OpenRelTable::openRel(char relName[ATTR_SIZE]) {
 
-	int ret = getRelId(relName);
+	int ret = pinRel(relName);
 	if (ret >= 0) {
-		// (checked using OpenRelTable::getRelId())
+		// (checked using OpenRelTable::pinRel())
 
 		// return that relation id;
 		return ret;
@@ -180,32 +232,16 @@ int OpenRelTable::openRel(char relName[ATTR_SIZE]) {
 	   using OpenRelTable::getFreeOpenRelTableEntry(). */
 	ret = getFreeOpenRelTableEntry();
 
-	if (ret == E_CACHEFULL) {
-		return E_CACHEFULL;
-	}
-
 	// let relId be used to store the free slot.
 	int relId = ret;
 
 	/****** Setting up Relation Cache entry for the relation ******/
 
-	/* search for the entry with relation name, relName, in the Relation Catalog using
-		BlockAccess::linearSearch().
-		Care should be taken to reset the searchIndex of the relation RELCAT_RELID
-		before calling linearSearch().*/
-
-	RelCatEntry relCatEntry;
-	RelCacheTable::getRelCatEntry(RELCAT_RELID, &relCatEntry);
-
-	AttrCatEntry attrCatEntry;
-	AttrCacheTable::getAttrCatEntry(RELCAT_RELID, RELCAT_REL_NAME_INDEX, &attrCatEntry);
-
-	RelCacheTable::resetSearchIndex(RELCAT_RELID);
-	Attribute attrVal;
-	strcpy(attrVal.sVal, relName);
+	/* look up the entry with relation name, relName, in the Relation Catalog
+		using the index of the Relation Catalog by name (RelCacheTable::getRelCatRecId()). */
 
 	// relcatRecId stores the rec-id of the relation `relName` in the Relation Catalog.
-	RecId relcatRecId = BlockAccess::linearSearch(RELCAT_RELID, attrCatEntry.attrName, attrVal, EQ);
+	RecId relcatRecId = RelCacheTable::getRelCatRecId(relName);
 
 	/* relcatRecId == {-1, -1} */
 	if (relcatRecId.block == -1 && relcatRecId.slot == -1) {
@@ -225,62 +261,19 @@ int OpenRelTable::openRel(char relName[ATTR_SIZE]) {
 	struct RelCacheEntry relCacheEntry;
 	RelCacheTable::recordToRelCatEntry(record, &relCacheEntry.relCatEntry);
 	relCacheEntry.recId = relcatRecId;
+	relCacheEntry.dirty = false;
+	relCacheEntry.reservedBlk = -1;
+	relCacheEntry.numReserved = 0;
+	relCacheEntry.freeSlotBlk = relCacheEntry.relCatEntry.firstBlk;
+	relCacheEntry.numBlocks = relCacheEntry.relCatEntry.firstBlk == -1 ? 0 : -1;
 
 	RelCacheTable::relCache[relId] = (struct RelCacheEntry*)malloc(sizeof(RelCacheEntry));
 	*(RelCacheTable::relCache[relId]) = relCacheEntry;
 
 	/****** Setting up Attribute Cache entry for the relation ******/
 
-	// let listHead be used to hold the head of the linked list of attrCache entries.
-	AttrCacheEntry* listHead, * curr;
-	listHead = curr = (AttrCacheEntry*)malloc(sizeof(AttrCacheEntry));
-
-	int numAttrs = relCacheEntry.relCatEntry.numAttrs;
-
-	for (int i = 0; i < numAttrs - 1; i++) {
-		curr->next = (AttrCacheEntry*)malloc(sizeof(AttrCacheEntry));
-		curr = curr->next;
-	}
-	curr->next = nullptr;
-
-	RelCacheTable::getRelCatEntry(ATTRCAT_RELID, &relCatEntry);
-	AttrCacheTable::getAttrCatEntry(ATTRCAT_RELID, ATTRCAT_REL_NAME_INDEX, &attrCatEntry);
-	strcpy(attrVal.sVal, relName);
-	char attrName[ATTR_SIZE];
-	strcpy(attrName, ATTRCAT_ATTR_RELNAME);
-
-	/*iterate over all the entries in the Attribute Catalog corresponding to each
-	attribute of the relation relName by multiple calls of BlockAccess::linearSearch()
-	care should be taken to reset the searchIndex of the relation, ATTRCAT_RELID,
-	corresponding to Attribute Catalog before the first call to linearSearch().*/
-
-	RelCacheTable::resetSearchIndex(ATTRCAT_RELID);
-	curr = listHead;
-
-	for (int i = 0; i < numAttrs; i++)
-	{
-		/* let attrcatRecId store a valid record id an entry of the relation, relName,
-		in the Attribute Catalog.*/
-		RecId attrcatRecId;
-		attrcatRecId = BlockAccess::linearSearch(ATTRCAT_RELID, attrName, attrVal, EQ);
-
-		/* read the record entry corresponding to attrcatRecId and create an
-		Attribute Cache entry on it using RecBuffer::getRecord() and
-		AttrCacheTable::recordToAttrCatEntry().
-		update the recId field of this Attribute Cache entry to attrcatRecId.
-		add the Attribute Cache entry to the linked list of listHead .*/
-		// NOTE: make sure to allocate memory for the AttrCacheEntry using malloc()
-		RecBuffer recBlock(attrcatRecId.block);
-		Attribute record[ATTRCAT_NO_ATTRS];
-		recBlock.getRecord(record, attrcatRecId.slot);
-		AttrCacheTable::recordToAttrCatEntry(record, &curr->attrCatEntry);
-		curr->recId = attrcatRecId;
-
-		curr = curr->next;
-	}
-
-	// set the relIdth entry of the AttrCacheTable to listHead.
-	AttrCacheTable::attrCache[relId] = listHead;
+	// the attribute cache of the relation is loaded from the Attribute Catalog
+	// on its first use (see AttrCacheTable::loadAttrCache())
 
 	/****** Setting up metadata in the Open Relation Table for the relation******/
 
@@ -288,6 +281,9 @@ int OpenRelTable::openRel(char relName[ATTR_SIZE]) {
 	// relName as the input.
 	tableMetaInfo[relId].free = false;
 	strcpy(tableMetaInfo[relId].relName, relName);
+	relIds[relName] = relId;
+	tableMetaInfo[relId].refCount = 0;
+	useRelId(relId);
 
 	return relId;
 }
@@ -296,7 +292,7 @@ int OpenRelTable::openRel(char relName[ATTR_SIZE]) {
 OpenRelTable::~OpenRelTable() {
 
     // close all open relations (from rel-id = 2 onwards. Why?)
-	for (int i = 2; i < MAX_OPEN; ++i) {
+	for (int i = 2; i < (int)tableMetaInfo.size(); ++i) {
 		if (!tableMetaInfo[i].free) {
 			OpenRelTable::closeRel(i); // we will implement this function later
 		}
@@ -306,49 +302,21 @@ OpenRelTable::~OpenRelTable() {
 
     //releasing the relation cache entry of the attribute catalog
 
-	/* If RelCatEntry of the ATTRCAT_RELID-th RelCacheEntry has been modified */
-    if (RelCacheTable::relCache[ATTRCAT_RELID]->dirty) {
-
-        /* Get the Relation Catalog entry from RelCacheTable::relCache
-        Then convert it to a record using RelCacheTable::relCatEntryToRecord(). */
-		RelCatEntry attrCatRelCacheEntry;
-		RelCacheTable::getRelCatEntry(ATTRCAT_RELID, &attrCatRelCacheEntry);
-		Attribute record[RELCAT_NO_ATTRS];
-		RelCacheTable::relCatEntryToRecord(&attrCatRelCacheEntry, record);
-
-		RecId recId = RelCacheTable::relCache[ATTRCAT_RELID]->recId;
-
-        // declaring an object of RecBuffer class to write back to the buffer
-        RecBuffer relCatBlock(recId.block);
-
-        // Write back to the buffer using relCatBlock.setRecord() with recId.slot
-		relCatBlock.setRecord(record, recId.slot);
-    }
+	// write back the cache entries of the catalog if they have been modified
+	writeBackRel(ATTRCAT_RELID);
+	StaticBuffer::freeReservedBlocks(RelCacheTable::relCache[ATTRCAT_RELID]->reservedBlk,
+	                                 RelCacheTable::relCache[ATTRCAT_RELID]->numReserved);
     // free the memory dynamically allocated to this RelCacheEntry
 	free(RelCacheTable::relCache[ATTRCAT_RELID]);
 	RelCacheTable::relCache[ATTRCAT_RELID] = nullptr;
 
     //releasing the relation cache entry of the relation catalog
 
-	/* If RelCatEntry of the RELCAT_RELID-th RelCacheEntry has been modified */
-    if(RelCacheTable::relCache[RELCAT_RELID]->dirty) {
-
-        /* Get the Relation Catalog entry from RelCacheTable::relCache
-        Then convert it to a record using RelCacheTable::relCatEntryToRecord(). */
-		RelCatEntry relCatRelCacheEntry; 
-		// --> not the cache entry, just to remember that cat entry is in cache
-		Attribute record[RELCAT_NO_ATTRS];
-		RelCacheTable::getRelCatEntry(RELCAT_RELID, &relCatRelCacheEntry);
-		RelCacheTable::relCatEntryToRecord(&relCatRelCacheEntry, record);
-
-		RecId recId = RelCacheTable::relCache[RELCAT_RELID]->recId;
+	// write back the cache entries of the catalog if they have been modified
+	writeBackRel(RELCAT_RELID);
+	StaticBuffer::freeReservedBlocks(RelCacheTable::relCache[RELCAT_RELID]->reservedBlk,
+	                                 RelCacheTable::relCache[RELCAT_RELID]->numReserved);
 
-        // declaring an object of RecBuffer class to write back to the buffer
-        RecBuffer relCatBlock(recId.block);
-
-        // Write back to the buffer using relCatBlock.setRecord() with recId.slot
-		relCatBlock.setRecord(record, recId.slot);
-    }
     // free the memory dynamically allocated for this RelCacheEntry
 	free(RelCacheTable::relCache[RELCAT_RELID]);
 	RelCacheTable::relCache[RELCAT_RELID] = nullptr;
@@ -356,13 +324,7 @@ OpenRelTable::~OpenRelTable() {
     // free the memory allocated for the attribute cache entries of the
     // relation catalog and the attribute catalog
 	for (int i = 0; i <= ATTRCAT_RELID; i++) {
-		// free attrcache
-		AttrCacheEntry* entry = AttrCacheTable::attrCache[i], * temp = nullptr;
-		while (entry) {
-			temp = entry;
-			entry = entry->next;
-			free(temp);
-		}
+		AttrCacheTable::freeAttrCache(i);
 	}
 	
 }
@@ -373,8 +335,8 @@ int OpenRelTable::closeRel(int relId) {
 		return E_NOTPERMITTED;
 	}
 
-	/* 0 <= relId < MAX_OPEN */
-	if (relId >= MAX_OPEN || relId < 0) {
+	/* 0 <= relId < size of the Open Relation Table */
+	if (relId >= (int)tableMetaInfo.size() || relId < 0) {
 		return E_OUTOFBOUND;
 	}
 
@@ -385,58 +347,75 @@ int OpenRelTable::closeRel(int relId) {
 
 	/****** Releasing the Relation Cache entry of the relation ******/
 
-	/* RelCatEntry of the relId-th Relation Cache entry has been modified */
-	if (RelCacheTable::relCache[relId]->dirty)
-	{
-
-		/* Get the Relation Catalog entry from RelCacheTable::relCache
-		Then convert it to a record using RelCacheTable::relCatEntryToRecord(). */
-		Attribute record[RELCAT_NO_ATTRS];
-		RelCatEntry relCatEntry;
-		RelCacheTable::getRelCatEntry(relId, &relCatEntry);
-		RelCacheTable::relCatEntryToRecord(&relCatEntry, record);
+	// write back the modified Relation Cache and Attribute Cache entries
+	writeBackRel(relId);
 
-		RecId recId = RelCacheTable::relCache[relId]->recId;
-		// declaring an object of RecBuffer class to write back to the buffer
-		RecBuffer relCatBlock(recId.block);
+	// free the record blocks preallocated for the relation and not used
+	StaticBuffer::freeReservedBlocks(RelCacheTable::relCache[relId]->reservedBlk,
+	                                 RelCacheTable::relCache[relId]->numReserved);
 
-		// Write back to the buffer using relCatBlock.setRecord() with recId.slot
-		relCatBlock.setRecord(record, recId.slot);
-	}
     // free the memory dynamically alloted to this Relation Cache entry
     // and assign nullptr to that entry
 	free(RelCacheTable::relCache[relId]);
 
 	/****** Releasing the Attribute Cache entry of the relation ******/
 
-	// free the memory allocated in the attribute caches which was
-	// allocated in the OpenRelTable::openRel() function
-	AttrCacheEntry* entry = AttrCacheTable::attrCache[relId], * temp = nullptr;
-	while (entry) {
-		// if the entry has been modified:
-		if (entry->dirty) {
-            /* Get the Attribute Catalog entry from attrCache
-             Then convert it to a record using AttrCacheTable::attrCatEntryToRecord().
-             Write back that entry by instantiating RecBuffer class. Use recId
-             member field and recBuffer.setRecord() */
-			Attribute rec[ATTRCAT_NO_ATTRS];
-			AttrCacheTable::attrCatEntryToRecord(&entry->attrCatEntry, rec);
-			
-			RecBuffer attrCatBlk(entry->recId.block);
-			attrCatBlk.setRecord(rec, entry->recId.slot);
-        }
-
-		temp = entry;
-		entry = entry->next;
-		free(temp);
-	}
+	// free the attribute cache, which was allocated on the first use of the relation
+	AttrCacheTable::freeAttrCache(relId);
 
 	/****** Set the Open Relation Table entry of the relation as free ******/
 	RelCacheTable::relCache[relId] = nullptr;
-	AttrCacheTable::attrCache[relId] = nullptr;
 
 	// update `metainfo` to set `relId` as a free slot
 	tableMetaInfo[relId].free = true;
+	relIds.erase(tableMetaInfo[relId].relName);
 
 	return SUCCESS;
-}
\ No newline at end of file
+}
+
+/* Writes the modified Relation Cache and Attribute Cache entries of an open relation back
+   to the catalog blocks in the buffer. The entries are updated in place in the caches while
+   the relation is open (the dirty flag is set by setRelCatEntry() / setAttrCatEntry()), so
+   each entry is written once however many times it was changed. */
+void OpenRelTable::writeBackRel(int relId) {
+	RelCacheEntry* relCacheEntry = RelCacheTable::relCache[relId];
+	if (relCacheEntry->dirty) {
+		Attribute record[RELCAT_NO_ATTRS];
+		RelCacheTable::relCatEntryToRecord(&relCacheEntry->relCatEntry, record);
+
+		RecBuffer relCatBlock(relCacheEntry->recId.block);
+		relCatBlock.setRecord(record, relCacheEntry->recId.slot);
+		relCacheEntry->dirty = false;
+	}
+
+	// (the attribute cache is empty if the relation's attributes were never used)
+	for (int i = 0; i < AttrCacheTable::numAttrs[relId]; i++) {
+		AttrCacheEntry* entry = &AttrCacheTable::attrCache[relId][i];
+		if (entry->dirty) {
+			Attribute record[ATTRCAT_NO_ATTRS];
+			AttrCacheTable::attrCatEntryToRecord(&entry->attrCatEntry, record);
+
+			RecBuffer attrCatBlock(entry->recId.block);
+			attrCatBlock.setRecord(record, entry->recId.slot);
+			entry->dirty = false;
+		}
+	}
+}
+
+/* Makes the changes of the session so far durable: the modified cache entries of the
+   open relations are written back, the modified buffer blocks and the block allocation
+   map are written to the run copy of the disk, and the run copy is copied to the disk and
+   synced. The relations stay open. A crash after a checkpoint loses only the commands
+   run after it; a crash during one leaves the disk as the previous checkpoint left it
+   (see Disk::sync()). */
+int OpenRelTable::checkpoint() {
+	for (int relId = 0; relId < (int)tableMetaInfo.size(); relId++) {
+		if (!tableMetaInfo[relId].free) {
+			writeBackRel(relId);
+		}
+	}
+
+	StaticBuffer::flush();
+
+	return Disk::sync();
+}
@@ -1,6 +1,11 @@
 #ifndef NITCBASE_OPENRELTABLE_H
 #define NITCBASE_OPENRELTABLE_H
 
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include "../BlockAccess/BlockAccess.h"
 #include "../Buffer/BlockBuffer.h"
 #include "../define/constants.h"
@@ -10,6 +15,8 @@
 typedef struct OpenRelTableMetaInfo {
   bool free;
   char relName[ATTR_SIZE];
+  int refCount;  // number of rel-ids of the relation handed out during the current command
+  int lastUsed;  // value of useClock when the relation was last used
 
 } OpenRelTableMetaInfo;
 
@@ -18,16 +25,29 @@ class OpenRelTable {
   // methods
   OpenRelTable();
   ~OpenRelTable();
-  static int getRelId(char relName[ATTR_SIZE]);
+  // whether the relation is open; nothing is loaded or pinned
+  static bool isOpen(char relName[ATTR_SIZE]);
+  // rel-id of an open relation, loading its cache entries again if they were evicted.
+  // The relation is pinned: it is not evicted until releaseRelIds() is called, which
+  // CommandHandler::handle() does at the end of every command, so a rel-id stays valid
+  // only for the command that obtained it.
+  static int pinRel(char relName[ATTR_SIZE]);
   static int openRel(char relName[ATTR_SIZE]);
   static int closeRel(int relId);
+  static void releaseRelIds();
+  static int checkpoint();
 
  private:
   // field
-  static OpenRelTableMetaInfo tableMetaInfo[MAX_OPEN];
+  static std::vector<OpenRelTableMetaInfo> tableMetaInfo;
+  static std::unordered_map<std::string, int> relIds;  // relation id of each open relation, by name
+  static std::unordered_set<std::string> evictedRels;  // open relations whose cache entries were evicted
+  static int useClock;
 
   // method
   static int getFreeOpenRelTableEntry();
+  static void useRelId(int relId);
+  static void writeBackRel(int relId);
 };
 
 #endif  // NITCBASE_OPENRELTABLE_H
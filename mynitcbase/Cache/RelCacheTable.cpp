@@ -3,14 +3,15 @@
 #include <cstring>
 // #include <cstdlib>
 
-RelCacheEntry* RelCacheTable::relCache[MAX_OPEN];
+std::vector<RelCacheEntry*> RelCacheTable::relCache(MAX_OPEN, nullptr);
+std::unordered_map<std::string, RecId> RelCacheTable::relCatIndex;
 
 /*
 Get the relation catalog entry for the relation with rel-id `relId` from the cache
 NOTE: this function expects the caller to allocate memory for `*relCatBuf`
 */
 int RelCacheTable::getRelCatEntry(int relId, RelCatEntry* relCatBuf) {
-  if (relId < 0 || relId >= MAX_OPEN) {
+  if (relId < 0 || relId >= (int)relCache.size()) {
     return E_OUTOFBOUND;
   }
 
@@ -51,8 +52,8 @@ void RelCacheTable::recordToRelCatEntry(union Attribute record[RELCAT_NO_ATTRS],
 NOTE: this function expects the caller to allocate memory for `*searchIndex`
 */
 int RelCacheTable::getSearchIndex(int relId, RecId* searchIndex) {
-  // check if 0 <= relId < MAX_OPEN and return E_OUTOFBOUND otherwise
-  if (relId >= MAX_OPEN || relId < 0) {
+  // check if relId is within the Open Relation Table and return E_OUTOFBOUND otherwise
+  if (relId >= (int)relCache.size() || relId < 0) {
     return E_OUTOFBOUND;
   }
 
@@ -70,8 +71,8 @@ int RelCacheTable::getSearchIndex(int relId, RecId* searchIndex) {
 // sets the searchIndex for the relation corresponding to relId
 int RelCacheTable::setSearchIndex(int relId, RecId* searchIndex) {
 
-  // check if 0 <= relId < MAX_OPEN and return E_OUTOFBOUND otherwise
-  if (relId >= MAX_OPEN || relId < 0) {
+  // check if relId is within the Open Relation Table and return E_OUTOFBOUND otherwise
+  if (relId >= (int)relCache.size() || relId < 0) {
     return E_OUTOFBOUND;
   }
 
@@ -92,11 +93,97 @@ int RelCacheTable::resetSearchIndex(int relId) {
   return setSearchIndex(relId, &si);
 }
 
+// gets the run of record blocks preallocated for the relation corresponding to relId
+int RelCacheTable::getReservedBlocks(int relId, int* reservedBlk, int* numReserved) {
+  if (relId >= (int)relCache.size() || relId < 0) {
+    return E_OUTOFBOUND;
+  }
+
+  if (relCache[relId] == nullptr) {
+    return E_RELNOTOPEN;
+  }
+
+  *reservedBlk = relCache[relId]->reservedBlk;
+  *numReserved = relCache[relId]->numReserved;
+  return SUCCESS;
+}
+
+// sets the run of record blocks preallocated for the relation corresponding to relId
+int RelCacheTable::setReservedBlocks(int relId, int reservedBlk, int numReserved) {
+  if (relId >= (int)relCache.size() || relId < 0) {
+    return E_OUTOFBOUND;
+  }
+
+  if (relCache[relId] == nullptr) {
+    return E_RELNOTOPEN;
+  }
+
+  relCache[relId]->reservedBlk = reservedBlk;
+  relCache[relId]->numReserved = numReserved;
+  return SUCCESS;
+}
+
+// gets the first block of the relation corresponding to relId that may have a free slot
+int RelCacheTable::getFreeSlotBlock(int relId, int* freeSlotBlk) {
+  if (relId >= (int)relCache.size() || relId < 0) {
+    return E_OUTOFBOUND;
+  }
+
+  if (relCache[relId] == nullptr) {
+    return E_RELNOTOPEN;
+  }
+
+  *freeSlotBlk = relCache[relId]->freeSlotBlk;
+  return SUCCESS;
+}
+
+// sets the first block of the relation corresponding to relId that may have a free slot
+int RelCacheTable::setFreeSlotBlock(int relId, int freeSlotBlk) {
+  if (relId >= (int)relCache.size() || relId < 0) {
+    return E_OUTOFBOUND;
+  }
+
+  if (relCache[relId] == nullptr) {
+    return E_RELNOTOPEN;
+  }
+
+  relCache[relId]->freeSlotBlk = freeSlotBlk;
+  return SUCCESS;
+}
+
+// gets the number of record blocks of the relation corresponding to relId (-1 if not counted yet)
+int RelCacheTable::getNumBlocks(int relId, int* numBlocks) {
+  if (relId >= (int)relCache.size() || relId < 0) {
+    return E_OUTOFBOUND;
+  }
+
+  if (relCache[relId] == nullptr) {
+    return E_RELNOTOPEN;
+  }
+
+  *numBlocks = relCache[relId]->numBlocks;
+  return SUCCESS;
+}
+
+// sets the number of record blocks of the relation corresponding to relId
+int RelCacheTable::setNumBlocks(int relId, int numBlocks) {
+  if (relId >= (int)relCache.size() || relId < 0) {
+    return E_OUTOFBOUND;
+  }
+
+  if (relCache[relId] == nullptr) {
+    return E_RELNOTOPEN;
+  }
+
+  relCache[relId]->numBlocks = numBlocks;
+  return SUCCESS;
+}
+
 /* Sets the Relation Catalog entry corresponding to the specified relation in the Relation Cache Table.
    NOTE: The caller should allocate memory for the `struct RelCatEntry` before calling the function. */
 int RelCacheTable::setRelCatEntry(int relId, RelCatEntry* relCatBuf) {
-  /* relId is outside the range [0, MAX_OPEN-1] */
-  if (relId < 0 || relId >= MAX_OPEN) {
+  /* relId is outside the Open Relation Table */
+  if (relId < 0 || relId >= (int)relCache.size()) {
     return E_OUTOFBOUND;
   }
 
@@ -128,4 +215,49 @@ void RelCacheTable::relCatEntryToRecord(RelCatEntry* relCatEntry, union Attribut
   record[RELCAT_LAST_BLOCK_INDEX].nVal = (double)relCatEntry->lastBlk;
   record[RELCAT_NO_SLOTS_PER_BLOCK_INDEX].nVal = (double)relCatEntry->numSlotsPerBlk;
 
-}
\ No newline at end of file
+}
+/* Returns the rec-id of the record of the relation `relName` in the Relation Catalog,
+   or {-1, -1} if there is no such relation. Replaces a linear search of the
+   Relation Catalog on the relation name. */
+RecId RelCacheTable::getRelCatRecId(const char relName[ATTR_SIZE]) {
+  auto entry = relCatIndex.find(relName);
+  if (entry == relCatIndex.end()) {
+    return RecId{-1, -1};
+  }
+  return entry->second;
+}
+
+/* Records that the record of the relation `relName` is at `recId` in the Relation
+   Catalog; a recId of {-1, -1} removes the relation. To be called whenever a record
+   of the Relation Catalog is inserted, deleted or renamed. */
+void RelCacheTable::setRelCatRecId(const char relName[ATTR_SIZE], RecId recId) {
+  if (recId.block == -1 && recId.slot == -1) {
+    relCatIndex.erase(relName);
+  } else {
+    relCatIndex[relName] = recId;
+  }
+}
+
+/* Loads the name of every relation in the Relation Catalog into relCatIndex. */
+void RelCacheTable::buildRelCatIndex() {
+  relCatIndex.clear();
+
+  for (int block = RELCAT_BLOCK; block != -1;) {
+    RecBuffer relCatBlock(block);
+    HeadInfo head;
+    relCatBlock.getHeader(&head);
+
+    unsigned char slotMap[head.numSlots];
+    relCatBlock.getSlotMap(slotMap);
+
+    for (int slot = 0; slot < head.numSlots; slot++) {
+      if (slotMap[slot] == SLOT_OCCUPIED) {
+        Attribute record[RELCAT_NO_ATTRS];
+        relCatBlock.getRecord(record, slot);
+        relCatIndex[record[RELCAT_REL_NAME_INDEX].sVal] = RecId{block, slot};
+      }
+    }
+
+    block = head.rblock;
+  }
+}
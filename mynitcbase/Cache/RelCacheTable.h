@@ -1,6 +1,10 @@
 #ifndef NITCBASE_RELCACHETABLE_H
 #define NITCBASE_RELCACHETABLE_H
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "../Buffer/BlockBuffer.h"
 #include "../define/constants.h"
 #include "../define/id.h"
@@ -20,6 +24,12 @@ typedef struct RelCacheEntry {
   bool dirty;
   RecId recId;
   RecId searchIndex;
+  int reservedBlk;  // first of the record blocks preallocated for the relation (see BlockAccess::getNewRecBlock())
+  int numReserved;  // number of preallocated blocks from reservedBlk
+  int freeSlotBlk;  // first block of the block list that may have a free slot, other than the
+                    // last block (-1 if none; see BlockAccess::bulkInsert())
+  int numBlocks;    // number of record blocks of the relation (-1 until counted; see
+                    // BlockAccess::getNumRecBlocks())
 
 } RelCacheEntry;
 
@@ -33,12 +43,22 @@ class RelCacheTable {
   static int getSearchIndex(int relId, RecId *searchIndex);
   static int setSearchIndex(int relId, RecId *searchIndex);
   static int resetSearchIndex(int relId);
+  static int getReservedBlocks(int relId, int *reservedBlk, int *numReserved);
+  static int setReservedBlocks(int relId, int reservedBlk, int numReserved);
+  static int getFreeSlotBlock(int relId, int *freeSlotBlk);
+  static int setFreeSlotBlock(int relId, int freeSlotBlk);
+  static int getNumBlocks(int relId, int *numBlocks);
+  static int setNumBlocks(int relId, int numBlocks);
+  static RecId getRelCatRecId(const char relName[ATTR_SIZE]);
+  static void setRelCatRecId(const char relName[ATTR_SIZE], RecId recId);
 
  private:
   // field
-  static RelCacheEntry *relCache[MAX_OPEN];
+  static std::vector<RelCacheEntry *> relCache;  // one entry per slot of the Open Relation Table
+  static std::unordered_map<std::string, RecId> relCatIndex;  // rec-id of the Relation Catalog record of each relation
 
   // methods
+  static void buildRelCatIndex();
   static void recordToRelCatEntry(union Attribute record[RELCAT_NO_ATTRS], RelCatEntry *relCatEntry);
   static void relCatEntryToRecord(RelCatEntry *relCatEntry, union Attribute record[RELCAT_NO_ATTRS]);
 };
@@ -1,24 +1,128 @@
 #include "Disk.h"
 
-#include <fstream>
-#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
 
 #include "../define/constants.h"
 
+int Disk::fd = -1;
+SuperBlock Disk::superBlock;
+
+/*
+ * Makes the bytes [from, to) of the file fd read as zeros. The range is punched out when it
+ * holds data, so that it becomes a hole again; zeros are written if the file system cannot
+ * punch holes.
+ */
+static void clearRange(int fd, off_t from, off_t to) {
+  off_t data = lseek(fd, from, SEEK_DATA);
+  if (data < 0 || data >= to) {
+    return;  // the range is a hole already
+  }
+  if (fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, data, to - data) == 0) {
+    return;
+  }
+  std::vector<char> zeros(std::min<off_t>(1 << 20, to - data), 0);
+  while (data < to) {
+    ssize_t n = pwrite(fd, zeros.data(), std::min<off_t>(zeros.size(), to - data), data);
+    if (n <= 0) {
+      break;
+    }
+    data += n;
+  }
+}
+
+/*
+ * Copies the disk image src to dst. Only the data regions of src are copied (they are found
+ * with SEEK_DATA / SEEK_HOLE), so the unwritten blocks of a large disk created by FDISK stay
+ * holes in the copy and copying takes time in proportion to the data on the disk.
+ * dst is overwritten in place rather than truncated first: ext4 flushes a file that is
+ * truncated to zero and written again when it is closed, which made up most of the time
+ * taken to start and end a session. Data left in dst where src has holes is cleared.
+ * Returns false if src or dst cannot be opened or a write to dst fails.
+ */
+static bool copyDisk(const char *src, const char *dst) {
+  int in = open(src, O_RDONLY);
+  if (in < 0) {
+    return false;
+  }
+  int out = open(dst, O_RDWR | O_CREAT, 0644);
+  if (out < 0) {
+    close(in);
+    return false;
+  }
+
+  bool ok = true;
+  off_t size = lseek(in, 0, SEEK_END);
+  if (ftruncate(out, size) != 0) {
+    ok = false;
+  }
+
+  // chunks that dst already holds are not written again (the run copy and the disk are
+  // the same at the start of a session, unless the disk was changed in between)
+  std::vector<char> buffer(1 << 16), current(1 << 16);
+  off_t data = lseek(in, 0, SEEK_DATA);
+  while (data >= 0 && data < size) {
+    off_t hole = lseek(in, data, SEEK_HOLE);
+    if (hole < 0) {
+      hole = size;
+    }
+    while (data < hole) {
+      ssize_t n = pread(in, buffer.data(), std::min<off_t>(buffer.size(), hole - data), data);
+      if (n <= 0) {
+        break;
+      }
+      if (pread(out, current.data(), n, data) != n || memcmp(buffer.data(), current.data(), n) != 0) {
+        if (pwrite(out, buffer.data(), n, data) != n) {
+          ok = false;
+          break;
+        }
+      }
+      data += n;
+    }
+    data = lseek(in, hole, SEEK_DATA);
+  }
+
+  // the holes of src read as zeros, clear whatever dst holds there
+  off_t hole = lseek(in, 0, SEEK_HOLE);
+  while (hole >= 0 && hole < size) {
+    off_t next = lseek(in, hole, SEEK_DATA);
+    if (next < 0) {
+      next = size;
+    }
+    clearRange(out, hole, next);
+    hole = lseek(in, next, SEEK_HOLE);
+  }
+
+  close(in);
+  close(out);
+  return ok;
+}
+
 /*
  * Used to make a temporary copy of the disk contents before the starting of a new session.
  * This ensures that if the system has a forced shutdown during the course of the session,
  * the previous state of the disk is not lost.
+ * The geometry of the disk is read from its superblock.
  */
 Disk::Disk() {
-  /* An efficient method to copy files */
   /* Copy Disk to Disk Run Copy */
-  std::ifstream src(DISK_PATH, std::ios::binary);
-  std::ofstream dst(DISK_RUN_COPY_PATH, std::ios::binary);
+  copyDisk(DISK_PATH, DISK_RUN_COPY_PATH);
 
-  dst << src.rdbuf();
-  src.close();
-  dst.close();
+  fd = open(DISK_RUN_COPY_PATH, O_RDWR);
+  if (fd < 0 || pread(fd, &superBlock, sizeof(superBlock), 0) != sizeof(superBlock) ||
+      memcmp(superBlock.magic, DISK_MAGIC, sizeof(superBlock.magic)) != 0 ||
+      superBlock.blockSize < MIN_BLOCK_SIZE || superBlock.blockSize > MAX_BLOCK_SIZE) {
+    superBlock.blockSize = BLOCK_SIZE;
+    superBlock.numBlocks = DISK_BLOCKS;
+    superBlock.bmapBlock = 0;
+    superBlock.bmapBlocks = BLOCK_ALLOCATION_MAP_SIZE;
+  }
 }
 
 /*
@@ -26,14 +130,54 @@ Disk::Disk() {
  * This ensures that these changes are visible in future sessions.
  */
 Disk::~Disk() {
-  /* An efficient method to copy files */
+  if (fd >= 0) {
+    close(fd);
+  }
+
   /* Copy Disk Run Copy to Disk */
-  std::ifstream src(DISK_RUN_COPY_PATH, std::ios::binary);
-  std::ofstream dst(DISK_PATH, std::ios::binary);
+  copyDisk(DISK_RUN_COPY_PATH, DISK_PATH);
+}
+
+/*
+ * Copies the run copy to the disk and flushes the disk to stable storage, so that the
+ * changes made so far are kept even if the session does not end gracefully.
+ * The caller writes the modified blocks to the run copy first (see OpenRelTable::checkpoint()).
+ * The disk is the only durable image, so it is never overwritten in place here: the run copy
+ * is copied to a temporary file next to it, which is synced and then renamed over the disk.
+ * A crash at any point leaves either the previous image or the new one.
+ */
+int Disk::sync() {
+  const char *tempPath = DISK_PATH ".tmp";
+  if (!copyDisk(DISK_RUN_COPY_PATH, tempPath)) {
+    unlink(tempPath);
+    return FAILURE;
+  }
+
+  int out = open(tempPath, O_RDWR);
+  if (out < 0 || fsync(out) != 0) {
+    if (out >= 0) {
+      close(out);
+    }
+    unlink(tempPath);
+    return FAILURE;
+  }
+  close(out);
+
+  if (rename(tempPath, DISK_PATH) != 0) {
+    unlink(tempPath);
+    return FAILURE;
+  }
 
-  dst << src.rdbuf();
-  src.close();
-  dst.close();
+  // the rename itself is made durable by syncing the directory of the disk
+  std::string diskPath = DISK_PATH;
+  std::string dirPath = diskPath.substr(0, diskPath.rfind('/'));
+  int dir = open(dirPath.c_str(), O_RDONLY | O_DIRECTORY);
+  if (dir < 0) {
+    return FAILURE;
+  }
+  int ret = fsync(dir);
+  close(dir);
+  return ret == 0 ? SUCCESS : FAILURE;
 }
 
 /*
@@ -43,14 +187,11 @@ Disk::~Disk() {
  * blockNum - Block number of the disk block to be read.
  */
 int Disk::readBlock(unsigned char *block, int blockNum) {
-  FILE *disk = fopen(DISK_RUN_COPY_PATH, "rb");
-  if (blockNum < 0 || blockNum > DISK_BLOCKS - 1) {
+  if (blockNum < 0 || blockNum > superBlock.numBlocks - 1) {
     return E_OUTOFBOUND;
   }
-  const int offset = blockNum * BLOCK_SIZE;
-  fseek(disk, offset, SEEK_SET);
-  fread(block, BLOCK_SIZE, 1, disk);
-  fclose(disk);
+  const off_t offset = (off_t)blockNum * superBlock.blockSize;
+  pread(fd, block, superBlock.blockSize, offset);
   return SUCCESS;
 }
 
@@ -61,13 +202,24 @@ int Disk::readBlock(unsigned char *block, int blockNum) {
  * blockNum - Block number of the disk block to be written into.
  */
 int Disk::writeBlock(unsigned char *block, int blockNum) {
-  FILE *disk = fopen(DISK_RUN_COPY_PATH, "rb+");
-  if (blockNum < 0 || blockNum > DISK_BLOCKS - 1) {
+  if (blockNum < 0 || blockNum > superBlock.numBlocks - 1) {
     return E_OUTOFBOUND;
   }
-  const int offset = blockNum * BLOCK_SIZE;
-  fseek(disk, offset, SEEK_SET);
-  fwrite(block, BLOCK_SIZE, 1, disk);
-  fclose(disk);
+  const off_t offset = (off_t)blockNum * superBlock.blockSize;
+  pwrite(fd, block, superBlock.blockSize, offset);
   return SUCCESS;
-}
\ No newline at end of file
+}
+
+/*
+ * Geometry of the disk of the session
+ */
+const SuperBlock &Disk::getSuperBlock() {
+  return superBlock;
+}
+
+/*
+ * Size in bytes of the blocks of the disk of the session
+ */
+int Disk::getBlockSize() {
+  return superBlock.blockSize;
+}
@@ -1,10 +1,32 @@
 #ifndef NITCBASE_H
 #define NITCBASE_H
+
+#include <cstdint>
+
+/* Block 0 of the disk, written by FDISK. Blocks are blockSize bytes (a power of two from
+   MIN_BLOCK_SIZE to MAX_BLOCK_SIZE). The block allocation map has one entry per block
+   and takes bmapBlocks blocks starting at bmapBlock. A disk formatted before superblocks
+   has DISK_BLOCKS blocks with the map in blocks 0 to BLOCK_ALLOCATION_MAP_SIZE - 1. */
+struct SuperBlock {
+  char magic[8];
+  int32_t blockSize;
+  int32_t numBlocks;
+  int32_t bmapBlock;
+  int32_t bmapBlocks;
+};
+
 class Disk {
  public:
   Disk();
   ~Disk();
   static int readBlock(unsigned char *block, int blockNum);
   static int writeBlock(unsigned char *block, int blockNum);
+  static const SuperBlock &getSuperBlock();
+  static int getBlockSize();
+  static int sync();
+
+ private:
+  static int fd;  // run copy of the disk, open for the session
+  static SuperBlock superBlock;
 };
-#endif  // NITCBASE_H
\ No newline at end of file
+#endif  // NITCBASE_H
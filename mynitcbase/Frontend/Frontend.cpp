@@ -33,6 +33,11 @@ int Frontend::alter_table_rename_column(char relname[ATTR_SIZE], char attrname_f
 	return Schema::renameAttr(relname, attrname_from, attrname_to);
 }
 
+int Frontend::analyze_table(char relname[ATTR_SIZE]) {
+	// Statistics::analyze
+	return Statistics::analyze(relname);
+}
+
 int Frontend::create_index(char relname[ATTR_SIZE], char attrname[ATTR_SIZE]) {
 	// Schema::createIndex
 	return Schema::createIndex(relname, attrname);
@@ -48,32 +53,63 @@ int Frontend::insert_into_table_values(char relname[ATTR_SIZE], int attr_count,
 	return Algebra::insert(relname, attr_count, attr_values);
 }
 
-int Frontend::select_from_table(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE]) {
+int Frontend::insert_into_table_from_file(char relname[ATTR_SIZE], const char *file_path, int *rows_inserted) {
+	// Algebra::insertFromFile
+	return Algebra::insertFromFile(relname, file_path, rows_inserted);
+}
+
+int Frontend::delete_from_table(char relname[ATTR_SIZE], int *rows_deleted) {
+	// Algebra::deleteRecords with no condition
+	return Algebra::deleteRecords(relname, 0, nullptr, nullptr, nullptr, nullptr, rows_deleted);
+}
+
+int Frontend::delete_from_table_where(char relname[ATTR_SIZE], int cond_count, char attributes[][ATTR_SIZE],
+	int ops[], char values[][ATTR_SIZE], int or_groups[], int *rows_deleted) {
+	// Algebra::deleteRecords
+	return Algebra::deleteRecords(relname, cond_count, attributes, ops, values, or_groups, rows_deleted);
+}
+
+int Frontend::update_table(char relname[ATTR_SIZE], int set_count, char set_attributes[][ATTR_SIZE],
+	char set_values[][ATTR_SIZE], int *rows_updated) {
+	// Algebra::update with no condition
+	return Algebra::update(relname, set_count, set_attributes, set_values, 0, nullptr, nullptr, nullptr, nullptr,
+		rows_updated);
+}
+
+int Frontend::update_table_where(char relname[ATTR_SIZE], int set_count, char set_attributes[][ATTR_SIZE],
+	char set_values[][ATTR_SIZE], int cond_count, char attributes[][ATTR_SIZE], int ops[], char values[][ATTR_SIZE],
+	int or_groups[], int *rows_updated) {
+	// Algebra::update
+	return Algebra::update(relname, set_count, set_attributes, set_values, cond_count, attributes, ops, values,
+		or_groups, rows_updated);
+}
+
+int Frontend::select_from_table(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE], int limit) {
 	// Algebra::project
-	return Algebra::project(relname_source, relname_target);
+	return Algebra::project(relname_source, relname_target, limit);
 }
 
 int Frontend::select_attrlist_from_table(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
-	int attr_count, char attr_list[][ATTR_SIZE]) {
+	int attr_count, char attr_list[][ATTR_SIZE], int limit) {
 	// Algebra::project
-	return Algebra::project(relname_source, relname_target, attr_count, attr_list);
+	return Algebra::project(relname_source, relname_target, attr_count, attr_list, limit);
 }
 
 int Frontend::select_from_table_where(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
-	char attribute[ATTR_SIZE], int op, char value[ATTR_SIZE]) {
-	return Algebra::select(relname_source, relname_target, attribute, op, value);
+	char attribute[ATTR_SIZE], int op, char value[ATTR_SIZE], int limit) {
+	return Algebra::select(relname_source, relname_target, attribute, op, value, limit);
 }
 
 int Frontend::select_attrlist_from_table_where(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
 	int attr_count, char attr_list[][ATTR_SIZE],
-	char attribute[ATTR_SIZE], int op, char value[ATTR_SIZE]) {
+	char attribute[ATTR_SIZE], int op, char value[ATTR_SIZE], int limit) {
 	// Algebra::select + Algebra::project??
 
 	// Call select() method of the Algebra Layer with correct arguments to
 	// create a temporary target relation with name ".temp" (use constant TEMP)
 	char tempRelName[ATTR_SIZE];
 	strcpy(tempRelName, TEMP);
-	int ret = Algebra::select(relname_source, tempRelName, attribute, op, value);
+	int ret = Algebra::select(relname_source, tempRelName, attribute, op, value, limit);
 
 	// TEMP will contain all the attributes of the source relation as it is the
 	// result of a select operation
@@ -106,23 +142,54 @@ int Frontend::select_attrlist_from_table_where(char relname_source[ATTR_SIZE], c
 	return ret;
 }
 
+int Frontend::select_from_table_where(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+	int cond_count, char attributes[][ATTR_SIZE], int ops[], char values[][ATTR_SIZE], int or_groups[], int limit) {
+	return Algebra::select(relname_source, relname_target, cond_count, attributes, ops, values, or_groups, limit);
+}
+
+int Frontend::select_attrlist_from_table_where(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+	int attr_count, char attr_list[][ATTR_SIZE],
+	int cond_count, char attributes[][ATTR_SIZE], int ops[], char values[][ATTR_SIZE], int or_groups[], int limit) {
+	// Algebra::select into TEMP, then Algebra::project into the target
+	// (as in the single condition version above)
+	char tempRelName[ATTR_SIZE];
+	strcpy(tempRelName, TEMP);
+	int ret = Algebra::select(relname_source, tempRelName, cond_count, attributes, ops, values, or_groups, limit);
+	if (ret != SUCCESS) {
+		return ret;
+	}
+
+	ret = OpenRelTable::openRel(tempRelName);
+	if (ret < 0) {
+		Schema::deleteRel(tempRelName);
+		return ret;
+	}
+
+	ret = Algebra::project(tempRelName, relname_target, attr_count, attr_list);
+
+	Schema::closeRel(tempRelName);
+	Schema::deleteRel(tempRelName);
+
+	return ret;
+}
+
 int Frontend::select_from_join_where(
 	char relname_source_one[ATTR_SIZE], char relname_source_two[ATTR_SIZE],
 	char relname_target[ATTR_SIZE], char join_attr_one[ATTR_SIZE], 
-	char join_attr_two[ATTR_SIZE]) {
+	char join_attr_two[ATTR_SIZE], int limit) {
 
 	// Algebra::join
-	return Algebra::join(relname_source_one, relname_source_two, relname_target, join_attr_one, join_attr_two);
+	return Algebra::join(relname_source_one, relname_source_two, relname_target, join_attr_one, join_attr_two, limit);
 }
 
 int Frontend::select_attrlist_from_join_where(
     char relname_source_one[ATTR_SIZE], char relname_source_two[ATTR_SIZE],
     char relname_target[ATTR_SIZE], char join_attr_one[ATTR_SIZE],
-    char join_attr_two[ATTR_SIZE], int attr_count, char attr_list[][ATTR_SIZE]) {
+    char join_attr_two[ATTR_SIZE], int attr_count, char attr_list[][ATTR_SIZE], int limit) {
 
     // Call join() method of the Algebra Layer with correct arguments to
     // create a temporary target relation with name TEMP.
-	int ret = Algebra::join(relname_source_one, relname_source_two, TEMP, join_attr_one, join_attr_two);
+	int ret = Algebra::join(relname_source_one, relname_source_two, TEMP, join_attr_one, join_attr_two, limit);
 
     // TEMP results from the join of the two source relation (and hence it
     // contains all attributes of the source relations except the join attribute
@@ -156,6 +223,23 @@ int Frontend::select_attrlist_from_join_where(
 	return ret;
 }
 
+int Frontend::select_from_table_order_by(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+	char attribute[ATTR_SIZE], bool descending, int limit) {
+	// Algebra::sort
+	return Algebra::sort(relname_source, relname_target, attribute, descending, limit);
+}
+
+int Frontend::select_aggregate_from_table(char relname_source[ATTR_SIZE], char attribute[ATTR_SIZE],
+	int aggregate, Attribute *result, int *result_type) {
+	// Algebra::aggregate
+	return Algebra::aggregate(relname_source, attribute, aggregate, result, result_type);
+}
+
+int Frontend::checkpoint() {
+	// OpenRelTable::checkpoint
+	return OpenRelTable::checkpoint();
+}
+
 int Frontend::custom_function(int argc, char argv[][ATTR_SIZE]) {
 	// argc gives the size of the argv array
 	// argv stores every token delimited by space and comma
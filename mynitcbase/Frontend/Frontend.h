@@ -3,6 +3,7 @@
 
 #include "../Algebra/Algebra.h"
 #include "../Schema/Schema.h"
+#include "../Statistics/Statistics.h"
 #include "../define/constants.h"
 
 class Frontend {
@@ -24,29 +25,69 @@ class Frontend {
 
   static int alter_table_rename_column(char relname[ATTR_SIZE], char attrname_from[16], char attrname_to[16]);
 
+  static int analyze_table(char relname[ATTR_SIZE]);
+
   // DML
   static int insert_into_table_values(char relname[ATTR_SIZE], int attr_count, char attr_values[][ATTR_SIZE]);
 
-  static int select_from_table(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE]);
+  static int insert_into_table_from_file(char relname[ATTR_SIZE], const char *file_path, int *rows_inserted);
+
+  static int delete_from_table(char relname[ATTR_SIZE], int *rows_deleted);
+
+  static int delete_from_table_where(char relname[ATTR_SIZE], int cond_count, char attributes[][ATTR_SIZE], int ops[],
+                                     char values[][ATTR_SIZE], int or_groups[], int *rows_deleted);
+
+  static int update_table(char relname[ATTR_SIZE], int set_count, char set_attributes[][ATTR_SIZE],
+                          char set_values[][ATTR_SIZE], int *rows_updated);
+
+  static int update_table_where(char relname[ATTR_SIZE], int set_count, char set_attributes[][ATTR_SIZE],
+                                char set_values[][ATTR_SIZE], int cond_count, char attributes[][ATTR_SIZE], int ops[],
+                                char values[][ATTR_SIZE], int or_groups[], int *rows_updated);
+
+  static int select_from_table(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                               int limit = NO_LIMIT);
 
   static int select_attrlist_from_table(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
-                                        int attr_count, char attr_list[][ATTR_SIZE]);
+                                        int attr_count, char attr_list[][ATTR_SIZE], int limit = NO_LIMIT);
+
+  static int select_from_table_where(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                     char attribute[ATTR_SIZE], int op, char value[ATTR_SIZE],
+                                     int limit = NO_LIMIT);
+
+  static int select_attrlist_from_table_where(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                              int attr_count, char attr_list[][ATTR_SIZE],
+                                              char attribute[ATTR_SIZE], int op, char value[ATTR_SIZE],
+                                              int limit = NO_LIMIT);
 
+  // WHERE with AND/OR: condition i is `attributes[i] ops[i] values[i]`; conditions with the
+  // same or_groups[i] are ANDed together and the groups are ORed
   static int select_from_table_where(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
-                                     char attribute[ATTR_SIZE], int op, char value[ATTR_SIZE]);
+                                     int cond_count, char attributes[][ATTR_SIZE], int ops[],
+                                     char values[][ATTR_SIZE], int or_groups[], int limit = NO_LIMIT);
 
   static int select_attrlist_from_table_where(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
                                               int attr_count, char attr_list[][ATTR_SIZE],
-                                              char attribute[ATTR_SIZE], int op, char value[ATTR_SIZE]);
+                                              int cond_count, char attributes[][ATTR_SIZE], int ops[],
+                                              char values[][ATTR_SIZE], int or_groups[], int limit = NO_LIMIT);
 
   static int select_from_join_where(char relname_source_one[ATTR_SIZE], char relname_source_two[ATTR_SIZE],
                                     char relname_target[ATTR_SIZE],
-                                    char join_attr_one[ATTR_SIZE], char join_attr_two[ATTR_SIZE]);
+                                    char join_attr_one[ATTR_SIZE], char join_attr_two[ATTR_SIZE],
+                                    int limit = NO_LIMIT);
 
   static int select_attrlist_from_join_where(char relname_source_one[ATTR_SIZE], char relname_source_two[ATTR_SIZE],
                                              char relname_target[ATTR_SIZE],
                                              char join_attr_one[ATTR_SIZE], char join_attr_two[ATTR_SIZE],
-                                             int attr_count, char attr_list[][ATTR_SIZE]);
+                                             int attr_count, char attr_list[][ATTR_SIZE], int limit = NO_LIMIT);
+
+  static int select_from_table_order_by(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                        char attribute[ATTR_SIZE], bool descending, int limit = NO_LIMIT);
+
+  static int select_aggregate_from_table(char relname_source[ATTR_SIZE], char attribute[ATTR_SIZE], int aggregate,
+                                         Attribute *result, int *result_type);
+
+  // Session
+  static int checkpoint();
 
   static int custom_function(int argc, char argv[][ATTR_SIZE]);
 };
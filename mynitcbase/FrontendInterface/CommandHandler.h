@@ -0,0 +1,80 @@
+#ifndef COMMAND_HANDLER_H
+#define COMMAND_HANDLER_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CommandParser.h"
+
+class CommandHandler {
+  typedef int (CommandHandler::*handlerFunction)(void);  // function pointer type
+
+ private:
+  // command to handler mappings
+  const std::vector<std::pair<CommandType, handlerFunction>> handlers = {
+      {CMD_HELP, &CommandHandler::helpHandler},
+      {CMD_EXIT, &CommandHandler::exitHandler},
+      {CMD_ECHO, &CommandHandler::echoHandler},
+      {CMD_RUN, &CommandHandler::runHandler},
+      {CMD_CHECKPOINT, &CommandHandler::checkpointHandler},
+      {CMD_OPEN_TABLE, &CommandHandler::openHandler},
+      {CMD_CLOSE_TABLE, &CommandHandler::closeHandler},
+      {CMD_CREATE_TABLE, &CommandHandler::createTableHandler},
+      {CMD_DROP_TABLE, &CommandHandler::dropTableHandler},
+      {CMD_CREATE_INDEX, &CommandHandler::createIndexHandler},
+      {CMD_DROP_INDEX, &CommandHandler::dropIndexHandler},
+      {CMD_RENAME_TABLE, &CommandHandler::renameTableHandler},
+      {CMD_RENAME_COLUMN, &CommandHandler::renameColumnHandler},
+      {CMD_ANALYZE, &CommandHandler::analyzeHandler},
+      {CMD_INSERT_SINGLE, &CommandHandler::insertSingleHandler},
+      {CMD_INSERT_MULTIPLE, &CommandHandler::insertFromFileHandler},
+      {CMD_DELETE_FROM, &CommandHandler::deleteFromHandler},
+      {CMD_UPDATE, &CommandHandler::updateHandler},
+      {CMD_SELECT_FROM, &CommandHandler::selectFromHandler},
+      {CMD_SELECT_FROM_WHERE, &CommandHandler::selectFromWhereHandler},
+      {CMD_SELECT_ATTR_FROM, &CommandHandler::selectAttrFromHandler},
+      {CMD_SELECT_ATTR_FROM_WHERE, &CommandHandler::selectAttrFromWhereHandler},
+      {CMD_SELECT_ORDER_BY, &CommandHandler::selectOrderByHandler},
+      {CMD_SELECT_AGGREGATE, &CommandHandler::selectAggregateHandler},
+      {CMD_SELECT_FROM_JOIN, &CommandHandler::selectFromJoinHandler},
+      {CMD_SELECT_ATTR_FROM_JOIN, &CommandHandler::selectAttrFromJoinHandler},
+      {CMD_CUSTOM, &CommandHandler::customFunctionHandler},
+  };
+
+  // handler functions
+  Command cmd;  // the command being handled, as parsed by CommandParser
+  int commandsSinceCheckpoint = 0;  // commands handled since the last checkpoint (see CHECKPOINT_INTERVAL)
+  int helpHandler();
+  int exitHandler();
+  int echoHandler();
+  int runHandler();
+  int checkpointHandler();
+  int openHandler();
+  int closeHandler();
+  int createTableHandler();
+  int dropTableHandler();
+  int createIndexHandler();
+  int dropIndexHandler();
+  int renameTableHandler();
+  int renameColumnHandler();
+  int analyzeHandler();
+  int insertSingleHandler();
+  int insertFromFileHandler();
+  int deleteFromHandler();
+  int updateHandler();
+  int selectFromHandler();
+  int selectFromWhereHandler();
+  int selectAttrFromHandler();
+  int selectAttrFromWhereHandler();
+  int selectOrderByHandler();
+  int selectAggregateHandler();
+  int selectFromJoinHandler();
+  int selectAttrFromJoinHandler();
+  int customFunctionHandler();
+
+ public:
+  int handle(const std::string command);
+};
+
+#endif  // COMMAND_HANDLER_H
@@ -0,0 +1,517 @@
+#include "CommandParser.h"
+
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <strings.h>
+
+static bool isWordChar(char c) {
+  return isalnum((unsigned char)c) || c == '_' || c == '-' || c == '#';
+}
+
+static bool isDigits(std::string_view text) {
+  size_t i = (text.size() > 1 && text[0] == '-') ? 1 : 0;
+  for (; i < text.size(); i++) {
+    if (!isdigit((unsigned char)text[i])) {
+      return false;
+    }
+  }
+  return !text.empty();
+}
+
+CommandParser::CommandParser(std::string_view command) : src(command) {
+  advance();
+}
+
+bool CommandParser::parse(const std::string &command, Command &cmd) {
+  CommandParser parser(command);
+  return parser.command(cmd);
+}
+
+/*** Lexer ***/
+
+// reads the next token into `token`
+void CommandParser::advance() {
+  while (pos < src.size() && isspace((unsigned char)src[pos])) {
+    pos++;
+  }
+
+  token.begin = pos;
+  token.op = -1;
+
+  if (pos == src.size()) {
+    token.type = TOKEN_END;
+  } else if (isWordChar(src[pos])) {
+    token.type = TOKEN_WORD;
+    while (pos < src.size() && isWordChar(src[pos])) {
+      pos++;
+    }
+  } else {
+    char c = src[pos++];
+    bool equalsNext = pos < src.size() && src[pos] == '=';
+    switch (c) {
+      case '*': token.type = TOKEN_STAR; break;
+      case ',': token.type = TOKEN_COMMA; break;
+      case '.': token.type = TOKEN_DOT; break;
+      case '/': token.type = TOKEN_SLASH; break;
+      case '(': token.type = TOKEN_LPAREN; break;
+      case ')': token.type = TOKEN_RPAREN; break;
+      case ';': token.type = TOKEN_SEMICOLON; break;
+      case '=':
+        token.type = TOKEN_OPERATOR;
+        token.op = EQ;
+        break;
+      case '<':
+      case '>':
+        token.type = TOKEN_OPERATOR;
+        token.op = c == '<' ? (equalsNext ? LE : LT) : (equalsNext ? GE : GT);
+        pos += equalsNext;
+        break;
+      case '!':
+        token.type = equalsNext ? TOKEN_OPERATOR : TOKEN_INVALID;
+        token.op = NE;
+        pos += equalsNext;
+        break;
+      default:
+        token.type = TOKEN_INVALID;
+    }
+  }
+
+  token.end = pos;
+  token.text = src.substr(token.begin, token.end - token.begin);
+}
+
+// restarts the lexer at `offset` (used after reading raw text)
+void CommandParser::skipTo(size_t offset) {
+  pos = offset;
+  advance();
+}
+
+// the raw text from the lookahead token to the end of the command, without a trailing ';'
+std::string_view CommandParser::rest() {
+  std::string_view text = src.substr(token.begin);
+  while (!text.empty() && isspace((unsigned char)text.back())) {
+    text.remove_suffix(1);
+  }
+  if (!text.empty() && text.back() == ';') {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+/*** Token matching ***/
+
+bool CommandParser::accept(TokenType type) {
+  if (token.type != type) {
+    return false;
+  }
+  advance();
+  return true;
+}
+
+bool CommandParser::isKeyword(const char *keyword) const {
+  return token.type == TOKEN_WORD && token.text.size() == strlen(keyword) &&
+         strncasecmp(token.text.data(), keyword, token.text.size()) == 0;
+}
+
+bool CommandParser::acceptKeyword(const char *keyword) {
+  if (!isKeyword(keyword)) {
+    return false;
+  }
+  advance();
+  return true;
+}
+
+// a relation name, or an attribute name (which may also contain '#')
+bool CommandParser::name(std::string &out, bool isAttr) {
+  if (token.type != TOKEN_WORD || (!isAttr && token.text.find('#') != std::string_view::npos)) {
+    return false;
+  }
+  out = token.text;
+  advance();
+  return true;
+}
+
+// a value: a word, or a number with a fractional part
+bool CommandParser::value(std::string &out) {
+  if (token.type != TOKEN_WORD || token.text.find('#') != std::string_view::npos) {
+    return false;
+  }
+
+  size_t valueEnd = token.end;
+  if (isDigits(token.text) && valueEnd + 1 < src.size() && src[valueEnd] == '.' &&
+      isdigit((unsigned char)src[valueEnd + 1])) {
+    valueEnd++;
+    while (valueEnd < src.size() && isdigit((unsigned char)src[valueEnd])) {
+      valueEnd++;
+    }
+  }
+
+  out = src.substr(token.begin, valueEnd - token.begin);
+  skipTo(valueEnd);
+  return true;
+}
+
+// a file path: words, '.' and '/' with no space in between
+bool CommandParser::path(std::string &out) {
+  size_t pathBegin = token.begin;
+  size_t pathEnd = token.begin;
+  while ((token.type == TOKEN_WORD || token.type == TOKEN_DOT || token.type == TOKEN_SLASH) &&
+         token.begin == pathEnd) {
+    pathEnd = token.end;
+    advance();
+  }
+
+  if (pathEnd == pathBegin) {
+    return false;
+  }
+  out = src.substr(pathBegin, pathEnd - pathBegin);
+  return true;
+}
+
+// an optional LIMIT clause
+bool CommandParser::limit(Command &cmd) {
+  if (!acceptKeyword("LIMIT")) {
+    return true;
+  }
+  if (token.type != TOKEN_WORD || !isdigit((unsigned char)token.text[0]) || !isDigits(token.text)) {
+    return false;
+  }
+  // a count that does not fit in an int is rejected, not wrapped around
+  const char *last = token.text.data() + token.text.size();
+  auto [ptr, ec] = std::from_chars(token.text.data(), last, cmd.limit);
+  if (ec != std::errc() || ptr != last) {
+    return false;
+  }
+  advance();
+  return true;
+}
+
+// an optional ';' ending the command
+bool CommandParser::end() {
+  accept(TOKEN_SEMICOLON);
+  return token.type == TOKEN_END;
+}
+
+/*** Grammar ***/
+
+bool CommandParser::command(Command &cmd) {
+  if (acceptKeyword("HELP")) {
+    cmd.type = CMD_HELP;
+    return end();
+  }
+  if (acceptKeyword("EXIT")) {
+    cmd.type = CMD_EXIT;
+    return end();
+  }
+  if (isKeyword("ECHO")) {
+    cmd.type = CMD_ECHO;
+    skipTo(token.end);
+    cmd.text = token.type == TOKEN_END ? "" : rest();
+    return true;
+  }
+  if (acceptKeyword("RUN")) {
+    cmd.type = CMD_RUN;
+    return path(cmd.text) && end();
+  }
+  if (acceptKeyword("CHECKPOINT")) {
+    cmd.type = CMD_CHECKPOINT;
+    return end();
+  }
+  if (acceptKeyword("OPEN")) {
+    cmd.type = CMD_OPEN_TABLE;
+    return acceptKeyword("TABLE") && name(cmd.relName, false) && end();
+  }
+  if (acceptKeyword("CLOSE")) {
+    cmd.type = CMD_CLOSE_TABLE;
+    return acceptKeyword("TABLE") && name(cmd.relName, false) && end();
+  }
+  if (acceptKeyword("CREATE")) {
+    return createCommand(cmd);
+  }
+  if (acceptKeyword("DROP")) {
+    return dropCommand(cmd);
+  }
+  if (acceptKeyword("ALTER")) {
+    return alterCommand(cmd);
+  }
+  if (acceptKeyword("ANALYZE")) {
+    cmd.type = CMD_ANALYZE;
+    return name(cmd.relName, false) && end();
+  }
+  if (acceptKeyword("INSERT")) {
+    return insertCommand(cmd);
+  }
+  if (acceptKeyword("DELETE")) {
+    return deleteCommand(cmd);
+  }
+  if (acceptKeyword("UPDATE")) {
+    return updateCommand(cmd);
+  }
+  if (acceptKeyword("SELECT")) {
+    return selectCommand(cmd);
+  }
+  if (isKeyword("FUNCTION")) {
+    cmd.type = CMD_CUSTOM;
+    skipTo(token.end);
+
+    // arguments are delimited by whitespace and commas
+    std::string_view args = token.type == TOKEN_END ? std::string_view() : rest();
+    size_t i = 0;
+    while (i < args.size()) {
+      if (isspace((unsigned char)args[i]) || args[i] == ',') {
+        i++;
+        continue;
+      }
+      size_t argEnd = i;
+      while (argEnd < args.size() && !isspace((unsigned char)args[argEnd]) && args[argEnd] != ',') {
+        argEnd++;
+      }
+      cmd.values.emplace_back(args.substr(i, argEnd - i));
+      i = argEnd;
+    }
+    return !cmd.values.empty();
+  }
+  return false;
+}
+
+// CREATE TABLE rel (attr STR|NUM, ...) | CREATE INDEX ON rel.attr
+bool CommandParser::createCommand(Command &cmd) {
+  if (acceptKeyword("TABLE")) {
+    cmd.type = CMD_CREATE_TABLE;
+    if (!name(cmd.relName, false) || !accept(TOKEN_LPAREN)) {
+      return false;
+    }
+    do {
+      std::string attrName;
+      if (!name(attrName, true)) {
+        return false;
+      }
+      if (acceptKeyword("STR")) {
+        cmd.attrTypes.push_back(STRING);
+      } else if (acceptKeyword("NUM")) {
+        cmd.attrTypes.push_back(NUMBER);
+      } else {
+        return false;
+      }
+      cmd.attrs.push_back(attrName);
+    } while (accept(TOKEN_COMMA));
+    return accept(TOKEN_RPAREN) && end();
+  }
+
+  if (acceptKeyword("INDEX")) {
+    cmd.type = CMD_CREATE_INDEX;
+    cmd.attrs.resize(1);
+    return acceptKeyword("ON") && name(cmd.relName, false) && accept(TOKEN_DOT) && name(cmd.attrs[0], true) &&
+           end();
+  }
+  return false;
+}
+
+// DROP TABLE rel | DROP INDEX ON rel.attr
+bool CommandParser::dropCommand(Command &cmd) {
+  if (acceptKeyword("TABLE")) {
+    cmd.type = CMD_DROP_TABLE;
+    return name(cmd.relName, false) && end();
+  }
+  if (acceptKeyword("INDEX")) {
+    cmd.type = CMD_DROP_INDEX;
+    cmd.attrs.resize(1);
+    return acceptKeyword("ON") && name(cmd.relName, false) && accept(TOKEN_DOT) && name(cmd.attrs[0], true) &&
+           end();
+  }
+  return false;
+}
+
+// ALTER TABLE RENAME rel TO new_rel | ALTER TABLE RENAME rel COLUMN attr TO new_attr
+bool CommandParser::alterCommand(Command &cmd) {
+  if (!acceptKeyword("TABLE") || !acceptKeyword("RENAME") || !name(cmd.relName, false)) {
+    return false;
+  }
+  if (acceptKeyword("COLUMN")) {
+    cmd.type = CMD_RENAME_COLUMN;
+    cmd.attrs.resize(2);
+    return name(cmd.attrs[0], true) && acceptKeyword("TO") && name(cmd.attrs[1], true) && end();
+  }
+  cmd.type = CMD_RENAME_TABLE;
+  return acceptKeyword("TO") && name(cmd.targetRelName, false) && end();
+}
+
+// INSERT INTO rel VALUES (value, ...) | INSERT INTO rel VALUES FROM file.csv
+bool CommandParser::insertCommand(Command &cmd) {
+  if (!acceptKeyword("INTO") || !name(cmd.relName, false) || !acceptKeyword("VALUES")) {
+    return false;
+  }
+
+  if (acceptKeyword("FROM")) {
+    cmd.type = CMD_INSERT_MULTIPLE;
+    if (!path(cmd.text) || cmd.text.find('/') != std::string::npos) {
+      return false;
+    }
+    // (only .csv files in the input files directory)
+    size_t length = cmd.text.size();
+    return length > 4 && strcasecmp(cmd.text.c_str() + length - 4, ".csv") == 0 && end();
+  }
+
+  cmd.type = CMD_INSERT_SINGLE;
+  if (!accept(TOKEN_LPAREN)) {
+    return false;
+  }
+  do {
+    cmd.values.emplace_back();
+    if (!value(cmd.values.back())) {
+      return false;
+    }
+  } while (accept(TOKEN_COMMA));
+  return accept(TOKEN_RPAREN) && end();
+}
+
+// DELETE FROM rel [WHERE condition]
+bool CommandParser::deleteCommand(Command &cmd) {
+  cmd.type = CMD_DELETE_FROM;
+  if (!acceptKeyword("FROM") || !name(cmd.relName, false)) {
+    return false;
+  }
+  if (acceptKeyword("WHERE") && !whereCondition(cmd)) {
+    return false;
+  }
+  return end();
+}
+
+// UPDATE rel SET attr = value, ... [WHERE condition]
+bool CommandParser::updateCommand(Command &cmd) {
+  cmd.type = CMD_UPDATE;
+  if (!name(cmd.relName, false) || !acceptKeyword("SET")) {
+    return false;
+  }
+  do {
+    cmd.attrs.emplace_back();
+    if (!name(cmd.attrs.back(), true) || token.type != TOKEN_OPERATOR || token.op != EQ) {
+      return false;
+    }
+    advance();
+    cmd.values.emplace_back();
+    if (!value(cmd.values.back())) {
+      return false;
+    }
+  } while (accept(TOKEN_COMMA));
+  if (acceptKeyword("WHERE") && !whereCondition(cmd)) {
+    return false;
+  }
+  return end();
+}
+
+/* SELECT MIN|MAX|COUNT(attr|*) FROM rel
+   SELECT *|attrlist FROM rel INTO target [WHERE condition] [LIMIT n]
+   SELECT *|attrlist FROM rel JOIN rel2 INTO target WHERE rel.attr = rel2.attr [LIMIT n]
+   SELECT * FROM rel INTO target ORDER BY attr [ASC|DESC] [LIMIT n] */
+bool CommandParser::selectCommand(Command &cmd) {
+  bool allAttrs = false;
+
+  if (accept(TOKEN_STAR)) {
+    allAttrs = true;
+  } else if ((isKeyword("MIN") || isKeyword("MAX") || isKeyword("COUNT")) && pos < src.size()) {
+    // (MIN, MAX and COUNT are aggregates only when followed by '(')
+    size_t next = pos;
+    while (next < src.size() && isspace((unsigned char)src[next])) {
+      next++;
+    }
+    if (next < src.size() && src[next] == '(') {
+      cmd.type = CMD_SELECT_AGGREGATE;
+      cmd.aggregate = isKeyword("MIN") ? AGG_MIN : isKeyword("MAX") ? AGG_MAX : AGG_COUNT;
+      advance();
+      accept(TOKEN_LPAREN);
+
+      cmd.attrs.resize(1);
+      if (token.type == TOKEN_STAR) {
+        cmd.attrs[0] = "*";
+        advance();
+      } else if (!name(cmd.attrs[0], true)) {
+        return false;
+      }
+      return accept(TOKEN_RPAREN) && acceptKeyword("FROM") && name(cmd.relName, false) && end();
+    }
+  }
+
+  if (!allAttrs) {
+    do {
+      cmd.attrs.emplace_back();
+      if (!name(cmd.attrs.back(), true)) {
+        return false;
+      }
+    } while (accept(TOKEN_COMMA));
+  }
+
+  if (!acceptKeyword("FROM") || !name(cmd.relName, false)) {
+    return false;
+  }
+
+  if (acceptKeyword("JOIN")) {
+    cmd.type = allAttrs ? CMD_SELECT_FROM_JOIN : CMD_SELECT_ATTR_FROM_JOIN;
+    return name(cmd.relNameTwo, false) && acceptKeyword("INTO") && name(cmd.targetRelName, false) &&
+           acceptKeyword("WHERE") && joinCondition(cmd) && limit(cmd) && end();
+  }
+
+  if (!acceptKeyword("INTO") || !name(cmd.targetRelName, false)) {
+    return false;
+  }
+
+  if (acceptKeyword("WHERE")) {
+    cmd.type = allAttrs ? CMD_SELECT_FROM_WHERE : CMD_SELECT_ATTR_FROM_WHERE;
+    if (!whereCondition(cmd)) {
+      return false;
+    }
+  } else if (allAttrs && acceptKeyword("ORDER")) {
+    cmd.type = CMD_SELECT_ORDER_BY;
+    cmd.attrs.resize(1);
+    if (!acceptKeyword("BY") || !name(cmd.attrs[0], true)) {
+      return false;
+    }
+    if (acceptKeyword("DESC")) {
+      cmd.descending = true;
+    } else {
+      acceptKeyword("ASC");
+    }
+  } else {
+    cmd.type = allAttrs ? CMD_SELECT_FROM : CMD_SELECT_ATTR_FROM;
+  }
+
+  return limit(cmd) && end();
+}
+
+// predicate {AND|OR predicate}, where predicate is `attr op value`
+bool CommandParser::whereCondition(Command &cmd) {
+  int orGroup = 0;
+  do {
+    WherePredicate predicate;
+    if (!name(predicate.attr, true) || token.type != TOKEN_OPERATOR) {
+      return false;
+    }
+    predicate.op = token.op;
+    advance();
+    if (!value(predicate.value)) {
+      return false;
+    }
+    predicate.orGroup = orGroup;
+    cmd.where.push_back(predicate);
+
+    if (acceptKeyword("OR")) {
+      orGroup++;
+    } else if (!acceptKeyword("AND")) {
+      break;
+    }
+  } while (true);
+  return true;
+}
+
+// rel.attr = rel2.attr
+bool CommandParser::joinCondition(Command &cmd) {
+  if (!name(cmd.joinRels[0], false) || !accept(TOKEN_DOT) || !name(cmd.joinAttrs[0], true)) {
+    return false;
+  }
+  if (token.type != TOKEN_OPERATOR || token.op != EQ) {
+    return false;
+  }
+  advance();
+  return name(cmd.joinRels[1], false) && accept(TOKEN_DOT) && name(cmd.joinAttrs[1], true);
+}
@@ -0,0 +1,149 @@
+#ifndef COMMAND_PARSER_H
+#define COMMAND_PARSER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../define/constants.h"
+
+enum CommandType {
+  /* External File System Commands */
+  CMD_HELP,
+  CMD_EXIT,
+  CMD_ECHO,
+  CMD_RUN,
+  CMD_CHECKPOINT,
+
+  /* DDL Commands */
+  CMD_CREATE_TABLE,
+  CMD_DROP_TABLE,
+  CMD_OPEN_TABLE,
+  CMD_CLOSE_TABLE,
+  CMD_CREATE_INDEX,
+  CMD_DROP_INDEX,
+  CMD_RENAME_TABLE,
+  CMD_RENAME_COLUMN,
+  CMD_ANALYZE,
+
+  /* DML Commands */
+  CMD_SELECT_FROM,
+  CMD_SELECT_ATTR_FROM,
+  CMD_SELECT_FROM_WHERE,
+  CMD_SELECT_ATTR_FROM_WHERE,
+  CMD_SELECT_FROM_JOIN,
+  CMD_SELECT_ATTR_FROM_JOIN,
+  CMD_SELECT_ORDER_BY,
+  CMD_SELECT_AGGREGATE,
+  CMD_INSERT_SINGLE,
+  CMD_INSERT_MULTIPLE,
+  CMD_DELETE_FROM,
+  CMD_UPDATE,
+  CMD_CUSTOM
+};
+
+/* A predicate `attr op value` of a WHERE clause. Predicates with the same orGroup
+   are ANDed together and the groups are ORed (AND binds tighter than OR). */
+struct WherePredicate {
+  std::string attr;
+  int op;
+  std::string value;
+  int orGroup;
+};
+
+/* The syntax tree of a command. Only the fields used by the command type are set:
+
+     relName        relation of a DDL/INSERT/DELETE/UPDATE command, source relation of a SELECT
+                    (first source relation of a join)
+     relNameTwo     second source relation of a join
+     targetRelName  INTO relation of a SELECT, new name of ALTER TABLE RENAME
+     attrs          attribute list of a SELECT, CREATE TABLE attribute names,
+                    index attribute, {old, new} name of a renamed column,
+                    ORDER BY / aggregate attribute, UPDATE SET attributes
+     attrTypes      CREATE TABLE attribute types (NUMBER or STRING)
+     joinRels       relations named by the join condition `R.a = S.b`, as written
+     joinAttrs      attributes named by the join condition, as written
+     values         INSERT values, UPDATE SET values, FUNCTION arguments
+     text           ECHO message, RUN / INSERT ... FROM file name
+*/
+struct Command {
+  CommandType type;
+  std::string relName;
+  std::string relNameTwo;
+  std::string targetRelName;
+  std::vector<std::string> attrs;
+  std::vector<int> attrTypes;
+  std::string joinRels[2];
+  std::string joinAttrs[2];
+  std::vector<std::string> values;
+  std::vector<WherePredicate> where;
+  std::string text;
+  int aggregate = AGG_COUNT;
+  bool descending = false;
+  int limit = NO_LIMIT;
+};
+
+/* Single pass lexer and recursive descent parser for the command language. Keywords
+   are case-insensitive; names and values keep their case. */
+class CommandParser {
+ public:
+  // parses `command` into `cmd`; returns false if it is not a valid command
+  static bool parse(const std::string &command, Command &cmd);
+
+ private:
+  enum TokenType {
+    TOKEN_WORD,  // name, keyword or value: [#A-Za-z0-9_-]+
+    TOKEN_STAR,
+    TOKEN_COMMA,
+    TOKEN_DOT,
+    TOKEN_SLASH,
+    TOKEN_LPAREN,
+    TOKEN_RPAREN,
+    TOKEN_SEMICOLON,
+    TOKEN_OPERATOR,  // = != < <= > >=
+    TOKEN_END,
+    TOKEN_INVALID
+  };
+
+  struct Token {
+    TokenType type;
+    std::string_view text;
+    size_t begin, end;  // offsets of the token in the command
+    int op;             // operator of a TOKEN_OPERATOR (EQ, NE, ...)
+  };
+
+  std::string_view src;
+  size_t pos = 0;  // offset just past `token`
+  Token token;     // lookahead
+
+  explicit CommandParser(std::string_view command);
+
+  // lexer
+  void advance();
+  void skipTo(size_t offset);
+  std::string_view rest();
+
+  // token matching
+  bool accept(TokenType type);
+  bool acceptKeyword(const char *keyword);
+  bool isKeyword(const char *keyword) const;
+  bool name(std::string &out, bool isAttr);
+  bool value(std::string &out);
+  bool path(std::string &out);
+  bool limit(Command &cmd);
+  bool end();
+
+  // grammar
+  bool command(Command &cmd);
+  bool createCommand(Command &cmd);
+  bool dropCommand(Command &cmd);
+  bool alterCommand(Command &cmd);
+  bool insertCommand(Command &cmd);
+  bool deleteCommand(Command &cmd);
+  bool updateCommand(Command &cmd);
+  bool selectCommand(Command &cmd);
+  bool whereCondition(Command &cmd);
+  bool joinCondition(Command &cmd);
+};
+
+#endif  // COMMAND_PARSER_H
@@ -9,46 +9,37 @@
 
 #include "FrontendInterface.h"
 
+#include "../Cache/OpenRelTable.h"
 #include "../Disk_Class/Disk.h"
 #include "../Frontend/Frontend.h"
 #include "../define/constants.h"
 
 using namespace std;
 
-int getOperator(string op_str);
-
 void attrToTruncatedArray(string nameString, char *nameArray);
 
 void printErrorMsg(int error);
 
 void printHelp();
 
-// extract tokens delimited by whitespace and comma
-vector<string> RegexHandler::extractTokens(string input) {
-  regex re("\\s*,\\s*|\\s+");
-  sregex_token_iterator first(input.begin(), input.end(), re, -1), last;
-  vector<string> tokens(first, last);
-  return tokens;
-}
-
 // handler functions
-int RegexHandler::helpHandler() {
+int CommandHandler::helpHandler() {
   printHelp();
   return SUCCESS;
 };
 
-int RegexHandler::exitHandler() {
+int CommandHandler::exitHandler() {
   return EXIT;
 };
 
-int RegexHandler::echoHandler() {
-  string message = m[1];
+int CommandHandler::echoHandler() {
+  string message = cmd.text;
   cout << message << endl;
   return SUCCESS;
 }
 
-int RegexHandler::runHandler() {
-  string fileName = m[1];
+int CommandHandler::runHandler() {
+  string fileName = cmd.text;
   const string filePath = BATCH_FILES_PATH;
   fstream commandsFile;
   commandsFile.open(filePath + fileName, ios::in);
@@ -76,9 +67,19 @@ int RegexHandler::runHandler() {
   return SUCCESS;  // error messages if any will be printed in recursive call to handle
 }
 
-int RegexHandler::openHandler() {
+int CommandHandler::checkpointHandler() {
+  int ret = Frontend::checkpoint();
+  if (ret == SUCCESS) {
+    commandsSinceCheckpoint = 0;
+    cout << "Checkpoint completed successfully" << endl;
+  }
+
+  return ret;
+}
+
+int CommandHandler::openHandler() {
   char relName[ATTR_SIZE];
-  attrToTruncatedArray(m[1], relName);
+  attrToTruncatedArray(cmd.relName, relName);
 
   int ret = Frontend::open_table(relName);
   if (ret == SUCCESS) {
@@ -87,9 +88,9 @@ int RegexHandler::openHandler() {
   return ret;
 }
 
-int RegexHandler::closeHandler() {
+int CommandHandler::closeHandler() {
   char relName[ATTR_SIZE];
-  attrToTruncatedArray(m[1], relName);
+  attrToTruncatedArray(cmd.relName, relName);
 
   int ret = Frontend::close_table(relName);
   if (ret == SUCCESS) {
@@ -99,13 +100,11 @@ int RegexHandler::closeHandler() {
   return ret;
 }
 
-int RegexHandler::createTableHandler() {
+int CommandHandler::createTableHandler() {
   char relName[ATTR_SIZE];
-  attrToTruncatedArray(m[1], relName);
+  attrToTruncatedArray(cmd.relName, relName);
 
-  vector<string> words = extractTokens(m[2]);
-
-  int attrCount = words.size() / 2;
+  int attrCount = cmd.attrs.size();
 
   if (attrCount > 125) {
     return E_MAXATTRS;
@@ -114,12 +113,9 @@ int RegexHandler::createTableHandler() {
   char attrNames[attrCount][ATTR_SIZE];
   int attrTypes[attrCount];
 
-  for (int i = 0, k = 0; i < attrCount; i++, k += 2) {
-    attrToTruncatedArray(words[k], attrNames[i]);
-    if (words[k + 1] == "STR")
-      attrTypes[i] = STRING;
-    else if (words[k + 1] == "NUM")
-      attrTypes[i] = NUMBER;
+  for (int i = 0; i < attrCount; i++) {
+    attrToTruncatedArray(cmd.attrs[i], attrNames[i]);
+    attrTypes[i] = cmd.attrTypes[i];
   }
 
   int ret = Frontend::create_table(relName, attrCount, attrNames, attrTypes);
@@ -130,9 +126,9 @@ int RegexHandler::createTableHandler() {
   return ret;
 }
 
-int RegexHandler::dropTableHandler() {
+int CommandHandler::dropTableHandler() {
   char relName[ATTR_SIZE];
-  attrToTruncatedArray(m[1], relName);
+  attrToTruncatedArray(cmd.relName, relName);
 
   int ret = Frontend::drop_table(relName);
   if (ret == SUCCESS) {
@@ -141,11 +137,11 @@ int RegexHandler::dropTableHandler() {
   return ret;
 }
 
-int RegexHandler::createIndexHandler() {
+int CommandHandler::createIndexHandler() {
   char relName[ATTR_SIZE], attrName[ATTR_SIZE];
 
-  attrToTruncatedArray(m[1], relName);
-  attrToTruncatedArray(m[2], attrName);
+  attrToTruncatedArray(cmd.relName, relName);
+  attrToTruncatedArray(cmd.attrs[0], attrName);
 
   int ret = Frontend::create_index(relName, attrName);
   if (ret == SUCCESS) {
@@ -155,10 +151,10 @@ int RegexHandler::createIndexHandler() {
   return ret;
 }
 
-int RegexHandler::dropIndexHandler() {
+int CommandHandler::dropIndexHandler() {
   char relName[ATTR_SIZE], attrName[ATTR_SIZE];
-  attrToTruncatedArray(m[1], relName);
-  attrToTruncatedArray(m[2], attrName);
+  attrToTruncatedArray(cmd.relName, relName);
+  attrToTruncatedArray(cmd.attrs[0], attrName);
 
   int ret = Frontend::drop_index(relName, attrName);
   if (ret == SUCCESS) {
@@ -168,11 +164,11 @@ int RegexHandler::dropIndexHandler() {
   return ret;
 }
 
-int RegexHandler::renameTableHandler() {
+int CommandHandler::renameTableHandler() {
   char oldRelName[ATTR_SIZE];
   char newRelName[ATTR_SIZE];
-  attrToTruncatedArray(m[1], oldRelName);
-  attrToTruncatedArray(m[2], newRelName);
+  attrToTruncatedArray(cmd.relName, oldRelName);
+  attrToTruncatedArray(cmd.targetRelName, newRelName);
 
   int ret = Frontend::alter_table_rename(oldRelName, newRelName);
   if (ret == SUCCESS) {
@@ -182,13 +178,13 @@ int RegexHandler::renameTableHandler() {
   return ret;
 }
 
-int RegexHandler::renameColumnHandler() {
+int CommandHandler::renameColumnHandler() {
   char relName[ATTR_SIZE];
   char oldColName[ATTR_SIZE];
   char newColName[ATTR_SIZE];
-  attrToTruncatedArray(m[1], relName);
-  attrToTruncatedArray(m[2], oldColName);
-  attrToTruncatedArray(m[3], newColName);
+  attrToTruncatedArray(cmd.relName, relName);
+  attrToTruncatedArray(cmd.attrs[0], oldColName);
+  attrToTruncatedArray(cmd.attrs[1], newColName);
 
   int ret = Frontend::alter_table_rename_column(relName, oldColName, newColName);
   if (ret == SUCCESS) {
@@ -198,16 +194,26 @@ int RegexHandler::renameColumnHandler() {
   return ret;
 }
 
-int RegexHandler::insertSingleHandler() {
+int CommandHandler::analyzeHandler() {
   char relName[ATTR_SIZE];
-  attrToTruncatedArray(m[1], relName);
+  attrToTruncatedArray(cmd.relName, relName);
 
-  vector<string> words = extractTokens(m[2]);
+  int ret = Frontend::analyze_table(relName);
+  if (ret == SUCCESS) {
+    cout << "Relation " << relName << " analyzed successfully" << endl;
+  }
+
+  return ret;
+}
+
+int CommandHandler::insertSingleHandler() {
+  char relName[ATTR_SIZE];
+  attrToTruncatedArray(cmd.relName, relName);
 
-  int attrCount = words.size();
+  int attrCount = cmd.values.size();
   char attrValues[attrCount][ATTR_SIZE];
   for (int i = 0; i < attrCount; ++i) {
-    attrToTruncatedArray(words[i], attrValues[i]);
+    attrToTruncatedArray(cmd.values[i], attrValues[i]);
   }
 
   int ret = Frontend::insert_into_table_values(relName, attrCount, attrValues);
@@ -218,89 +224,108 @@ int RegexHandler::insertSingleHandler() {
   return ret;
 }
 
-int RegexHandler::insertFromFileHandler() {
+int CommandHandler::insertFromFileHandler() {
   char relName[ATTR_SIZE];
-  attrToTruncatedArray(m[1], relName);
+  attrToTruncatedArray(cmd.relName, relName);
 
-  string filePath = string(INPUT_FILES_PATH) + m[2].str();
+  string filePath = string(INPUT_FILES_PATH) + cmd.text;
   std::cout << "File path: " << filePath << endl;
 
-  ifstream file(filePath);
-  if (!file.is_open()) {
+  int rowsInserted;
+  int retVal = Frontend::insert_into_table_from_file(relName, filePath.c_str(), &rowsInserted);
+
+  if (retVal == E_FILENOTEXIST) {
     cout << "Invalid file path or file does not exist" << endl;
     return FAILURE;
   }
 
-  string errorMsg("");
-  string fileLine;
-
-  int retVal = SUCCESS;
-  int columnCount = -1, lineNumber = 1;
-  while (getline(file, fileLine)) {
-    vector<string> row;
-
-    stringstream lineStream(fileLine);
-
-    string item;
-    while (getline(lineStream, item, ',')) {
-      if (item.size() == 0) {
-        errorMsg += "Null values not allowed in attribute values\n";
-        retVal = FAILURE;
-        break;
-      }
-      row.push_back(item);
-    }
-    if (retVal == FAILURE) {
-      break;
-    }
-
-    if (columnCount == -1) {
-      columnCount = row.size();
-    } else if (columnCount != row.size()) {
-      errorMsg += "Mismatch in number of attributes\n";
-      retVal = FAILURE;
-      break;
-    }
-
-    char rowArray[columnCount][ATTR_SIZE];
-    for (int i = 0; i < columnCount; ++i) {
-      attrToTruncatedArray(row[i], rowArray[i]);
+  if (retVal == SUCCESS || retVal == E_INDEX_BLOCKS_RELEASED) {
+    cout << rowsInserted << " rows inserted successfully" << endl;
+  } else {
+    if (rowsInserted > 0) {
+      std::cout << "Rows till line " << rowsInserted << " successfully inserted\n";
     }
+    std::cout << "Insertion error at line " << rowsInserted + 1 << " in file \n";
+    std::cout << "Subsequent lines will be skipped\n";
+  }
 
-    retVal = Frontend::insert_into_table_values(relName, columnCount, rowArray);
-
-    if (retVal != SUCCESS) {
-      break;
-    }
+  return retVal;
+}
 
-    lineNumber++;
+int CommandHandler::deleteFromHandler() {
+  char relName[ATTR_SIZE];
+  attrToTruncatedArray(cmd.relName, relName);
+
+  int condCount = cmd.where.size();
+  char attributes[condCount][ATTR_SIZE];
+  char values[condCount][ATTR_SIZE];
+  int ops[condCount], orGroups[condCount];
+  for (int i = 0; i < condCount; i++) {
+    attrToTruncatedArray(cmd.where[i].attr, attributes[i]);
+    attrToTruncatedArray(cmd.where[i].value, values[i]);
+    ops[i] = cmd.where[i].op;
+    orGroups[i] = cmd.where[i].orGroup;
+  }
+
+  int rowsDeleted;
+  int ret;
+  if (condCount == 0) {
+    ret = Frontend::delete_from_table(relName, &rowsDeleted);
+  } else {
+    ret = Frontend::delete_from_table_where(relName, condCount, attributes, ops, values, orGroups, &rowsDeleted);
+  }
+  if (ret == SUCCESS || ret == E_INDEX_BLOCKS_RELEASED) {
+    cout << rowsDeleted << " rows deleted successfully" << endl;
   }
 
-  file.close();
+  return ret;
+}
 
-  if (retVal == SUCCESS) {
-    cout << lineNumber - 1 << " rows inserted successfully" << endl;
+int CommandHandler::updateHandler() {
+  char relName[ATTR_SIZE];
+  attrToTruncatedArray(cmd.relName, relName);
+
+  int setCount = cmd.attrs.size();
+  char setAttributes[setCount][ATTR_SIZE];
+  char setValues[setCount][ATTR_SIZE];
+  for (int i = 0; i < setCount; i++) {
+    attrToTruncatedArray(cmd.attrs[i], setAttributes[i]);
+    attrToTruncatedArray(cmd.values[i], setValues[i]);
+  }
+
+  int condCount = cmd.where.size();
+  char attributes[condCount][ATTR_SIZE];
+  char values[condCount][ATTR_SIZE];
+  int ops[condCount], orGroups[condCount];
+  for (int i = 0; i < condCount; i++) {
+    attrToTruncatedArray(cmd.where[i].attr, attributes[i]);
+    attrToTruncatedArray(cmd.where[i].value, values[i]);
+    ops[i] = cmd.where[i].op;
+    orGroups[i] = cmd.where[i].orGroup;
+  }
+
+  int rowsUpdated;
+  int ret;
+  if (condCount == 0) {
+    ret = Frontend::update_table(relName, setCount, setAttributes, setValues, &rowsUpdated);
   } else {
-    if (lineNumber > 1) {
-      std::cout << "Rows till line " << lineNumber - 1 << " successfully inserted\n";
-    }
-    std::cout << "Insertion error at line " << lineNumber << " in file \n";
-    std::cout << "Subsequent lines will be skipped\n";
-    if (retVal == FAILURE) {
-      std::cout << "Error:" << errorMsg;
-    }
+    ret = Frontend::update_table_where(relName, setCount, setAttributes, setValues, condCount, attributes, ops,
+                                       values, orGroups, &rowsUpdated);
+  }
+  if (ret == SUCCESS || ret == E_INDEX_BLOCKS_RELEASED) {
+    cout << rowsUpdated << " rows updated successfully" << endl;
   }
 
-  return retVal;
+  return ret;
 }
 
-int RegexHandler::selectFromHandler() {
+int CommandHandler::selectFromHandler() {
   char sourceRelName[ATTR_SIZE];
   char targetRelName[ATTR_SIZE];
-  attrToTruncatedArray(m[1], sourceRelName);
-  attrToTruncatedArray(m[2], targetRelName);
+  attrToTruncatedArray(cmd.relName, sourceRelName);
+  attrToTruncatedArray(cmd.targetRelName, targetRelName);
 
-  int ret = Frontend::select_from_table(sourceRelName, targetRelName);
+  int ret = Frontend::select_from_table(sourceRelName, targetRelName, cmd.limit);
   if (ret == SUCCESS) {
     cout << "Selected successfully into " << targetRelName << endl;
   }
@@ -308,18 +333,31 @@ int RegexHandler::selectFromHandler() {
   return ret;
 }
 
-int RegexHandler::selectFromWhereHandler() {
+int CommandHandler::selectFromWhereHandler() {
   char sourceRelName[ATTR_SIZE];
   char targetRelName[ATTR_SIZE];
-  char attribute[ATTR_SIZE];
-  char valueStr[ATTR_SIZE];
-  attrToTruncatedArray(m[1], sourceRelName);
-  attrToTruncatedArray(m[2], targetRelName);
-  attrToTruncatedArray(m[3], attribute);
-  int op = getOperator(m[4]);
-  attrToTruncatedArray(m[5], valueStr);
-
-  int ret = Frontend::select_from_table_where(sourceRelName, targetRelName, attribute, op, valueStr);
+  attrToTruncatedArray(cmd.relName, sourceRelName);
+  attrToTruncatedArray(cmd.targetRelName, targetRelName);
+
+  int condCount = cmd.where.size();
+  char attributes[condCount][ATTR_SIZE];
+  char values[condCount][ATTR_SIZE];
+  int ops[condCount], orGroups[condCount];
+  for (int i = 0; i < condCount; i++) {
+    attrToTruncatedArray(cmd.where[i].attr, attributes[i]);
+    attrToTruncatedArray(cmd.where[i].value, values[i]);
+    ops[i] = cmd.where[i].op;
+    orGroups[i] = cmd.where[i].orGroup;
+  }
+
+  int ret;
+  if (condCount == 1) {
+    ret = Frontend::select_from_table_where(sourceRelName, targetRelName, attributes[0], ops[0], values[0],
+                                            cmd.limit);
+  } else {
+    ret = Frontend::select_from_table_where(sourceRelName, targetRelName, condCount, attributes, ops, values,
+                                            orGroups, cmd.limit);
+  }
   if (ret == SUCCESS) {
     cout << "Selected successfully into " << targetRelName << endl;
   }
@@ -327,21 +365,19 @@ int RegexHandler::selectFromWhereHandler() {
   return ret;
 }
 
-int RegexHandler::selectAttrFromHandler() {
+int CommandHandler::selectAttrFromHandler() {
   char sourceRelName[ATTR_SIZE];
   char targetRelName[ATTR_SIZE];
-  attrToTruncatedArray(m[2], sourceRelName);
-  attrToTruncatedArray(m[3], targetRelName);
+  attrToTruncatedArray(cmd.relName, sourceRelName);
+  attrToTruncatedArray(cmd.targetRelName, targetRelName);
 
-  vector<string> words = extractTokens(m[1]);
-
-  int attrCount = words.size();
+  int attrCount = cmd.attrs.size();
   char attrNames[attrCount][ATTR_SIZE];
   for (int i = 0; i < attrCount; i++) {
-    attrToTruncatedArray(words[i], attrNames[i]);
+    attrToTruncatedArray(cmd.attrs[i], attrNames[i]);
   }
 
-  int ret = Frontend::select_attrlist_from_table(sourceRelName, targetRelName, attrCount, attrNames);
+  int ret = Frontend::select_attrlist_from_table(sourceRelName, targetRelName, attrCount, attrNames, cmd.limit);
   if (ret == SUCCESS) {
     cout << "Selected successfully into " << targetRelName << endl;
   }
@@ -349,28 +385,55 @@ int RegexHandler::selectAttrFromHandler() {
   return ret;
 }
 
-int RegexHandler::selectAttrFromWhereHandler() {
+int CommandHandler::selectAttrFromWhereHandler() {
   char sourceRelName[ATTR_SIZE];
   char targetRelName[ATTR_SIZE];
-  char attribute[ATTR_SIZE];
-  char value[ATTR_SIZE];
 
-  attrToTruncatedArray(m[2], sourceRelName);
-  attrToTruncatedArray(m[3], targetRelName);
-  attrToTruncatedArray(m[4], attribute);
-  int op = getOperator(m[5]);
-  attrToTruncatedArray(m[6], value);
+  attrToTruncatedArray(cmd.relName, sourceRelName);
+  attrToTruncatedArray(cmd.targetRelName, targetRelName);
 
-  vector<string> attrTokens = extractTokens(m[1]);
+  int condCount = cmd.where.size();
+  char attributes[condCount][ATTR_SIZE];
+  char values[condCount][ATTR_SIZE];
+  int ops[condCount], orGroups[condCount];
+  for (int i = 0; i < condCount; i++) {
+    attrToTruncatedArray(cmd.where[i].attr, attributes[i]);
+    attrToTruncatedArray(cmd.where[i].value, values[i]);
+    ops[i] = cmd.where[i].op;
+    orGroups[i] = cmd.where[i].orGroup;
+  }
 
-  int attrCount = attrTokens.size();
+  int attrCount = cmd.attrs.size();
   char attrNames[attrCount][ATTR_SIZE];
   for (int i = 0; i < attrCount; i++) {
-    attrToTruncatedArray(attrTokens[i], attrNames[i]);
+    attrToTruncatedArray(cmd.attrs[i], attrNames[i]);
+  }
+
+  int ret;
+  if (condCount == 1) {
+    ret = Frontend::select_attrlist_from_table_where(sourceRelName, targetRelName, attrCount, attrNames,
+                                                     attributes[0], ops[0], values[0], cmd.limit);
+  } else {
+    ret = Frontend::select_attrlist_from_table_where(sourceRelName, targetRelName, attrCount, attrNames, condCount,
+                                                     attributes, ops, values, orGroups, cmd.limit);
   }
+  if (ret == SUCCESS) {
+    cout << "Selected successfully into " << targetRelName << endl;
+  }
+
+  return ret;
+}
+
+int CommandHandler::selectOrderByHandler() {
+  char sourceRelName[ATTR_SIZE];
+  char targetRelName[ATTR_SIZE];
+  char attribute[ATTR_SIZE];
+  attrToTruncatedArray(cmd.relName, sourceRelName);
+  attrToTruncatedArray(cmd.targetRelName, targetRelName);
+  attrToTruncatedArray(cmd.attrs[0], attribute);
 
-  int ret = Frontend::select_attrlist_from_table_where(sourceRelName, targetRelName, attrCount, attrNames,
-                                                       attribute, op, value);
+  int ret = Frontend::select_from_table_order_by(sourceRelName, targetRelName, attribute, cmd.descending,
+                                                 cmd.limit);
   if (ret == SUCCESS) {
     cout << "Selected successfully into " << targetRelName << endl;
   }
@@ -378,23 +441,46 @@ int RegexHandler::selectAttrFromWhereHandler() {
   return ret;
 }
 
-int RegexHandler::selectFromJoinHandler() {
+int CommandHandler::selectAggregateHandler() {
+  char sourceRelName[ATTR_SIZE];
+  char attribute[ATTR_SIZE];
+  attrToTruncatedArray(cmd.attrs[0], attribute);
+  attrToTruncatedArray(cmd.relName, sourceRelName);
+
+  int aggregate = cmd.aggregate;
+  string function = aggregate == AGG_MIN ? "MIN" : aggregate == AGG_MAX ? "MAX" : "COUNT";
+
+  Attribute result;
+  int resultType;
+  int ret = Frontend::select_aggregate_from_table(sourceRelName, attribute, aggregate, &result, &resultType);
+  if (ret == SUCCESS) {
+    if (resultType == NUMBER) {
+      printf("%s(%s) = %.15g\n", function.c_str(), cmd.attrs[0].c_str(), result.nVal);
+    } else {
+      printf("%s(%s) = %s\n", function.c_str(), cmd.attrs[0].c_str(), result.sVal);
+    }
+  }
+
+  return ret;
+}
+
+int CommandHandler::selectFromJoinHandler() {
   char sourceRelOneName[ATTR_SIZE];
   char sourceRelTwoName[ATTR_SIZE];
   char targetRelName[ATTR_SIZE];
   char joinAttributeOne[ATTR_SIZE];
   char joinAttributeTwo[ATTR_SIZE];
 
-  attrToTruncatedArray(m[1], sourceRelOneName);
-  attrToTruncatedArray(m[2], sourceRelTwoName);
-  attrToTruncatedArray(m[3], targetRelName);
+  attrToTruncatedArray(cmd.relName, sourceRelOneName);
+  attrToTruncatedArray(cmd.relNameTwo, sourceRelTwoName);
+  attrToTruncatedArray(cmd.targetRelName, targetRelName);
 
-  if (m[1] == m[4] && m[2] == m[6]) {
-    attrToTruncatedArray(m[5], joinAttributeOne);
-    attrToTruncatedArray(m[7], joinAttributeTwo);
-  } else if (m[1] == m[6] && m[2] == m[4]) {
-    attrToTruncatedArray(m[7], joinAttributeOne);
-    attrToTruncatedArray(m[5], joinAttributeTwo);
+  if (cmd.relName == cmd.joinRels[0] && cmd.relNameTwo == cmd.joinRels[1]) {
+    attrToTruncatedArray(cmd.joinAttrs[0], joinAttributeOne);
+    attrToTruncatedArray(cmd.joinAttrs[1], joinAttributeTwo);
+  } else if (cmd.relName == cmd.joinRels[1] && cmd.relNameTwo == cmd.joinRels[0]) {
+    attrToTruncatedArray(cmd.joinAttrs[1], joinAttributeOne);
+    attrToTruncatedArray(cmd.joinAttrs[0], joinAttributeTwo);
 
   } else {
     cout << "Syntax Error: Relation names do not match" << endl;
@@ -402,7 +488,7 @@ int RegexHandler::selectFromJoinHandler() {
   }
 
   int ret = Frontend::select_from_join_where(sourceRelOneName, sourceRelTwoName, targetRelName,
-                                             joinAttributeOne, joinAttributeTwo);
+                                             joinAttributeOne, joinAttributeTwo, cmd.limit);
   if (ret == SUCCESS) {
     cout << "Selected successfully into " << targetRelName << endl;
   }
@@ -410,50 +496,46 @@ int RegexHandler::selectFromJoinHandler() {
   return ret;
 }
 
-int RegexHandler::selectAttrFromJoinHandler() {
+int CommandHandler::selectAttrFromJoinHandler() {
   char sourceRelOneName[ATTR_SIZE];
   char sourceRelTwoName[ATTR_SIZE];
   char targetRelName[ATTR_SIZE];
   char joinAttributeOne[ATTR_SIZE];
   char joinAttributeTwo[ATTR_SIZE];
 
-  attrToTruncatedArray(m[2], sourceRelOneName);
-  attrToTruncatedArray(m[3], sourceRelTwoName);
-  attrToTruncatedArray(m[4], targetRelName);
+  attrToTruncatedArray(cmd.relName, sourceRelOneName);
+  attrToTruncatedArray(cmd.relNameTwo, sourceRelTwoName);
+  attrToTruncatedArray(cmd.targetRelName, targetRelName);
 
-  if (m[2] == m[5] && m[3] == m[7]) {
-    attrToTruncatedArray(m[6], joinAttributeOne);
-    attrToTruncatedArray(m[8], joinAttributeTwo);
-  } else if (m[2] == m[7] && m[3] == m[5]) {
-    attrToTruncatedArray(m[8], joinAttributeOne);
-    attrToTruncatedArray(m[6], joinAttributeTwo);
+  if (cmd.relName == cmd.joinRels[0] && cmd.relNameTwo == cmd.joinRels[1]) {
+    attrToTruncatedArray(cmd.joinAttrs[0], joinAttributeOne);
+    attrToTruncatedArray(cmd.joinAttrs[1], joinAttributeTwo);
+  } else if (cmd.relName == cmd.joinRels[1] && cmd.relNameTwo == cmd.joinRels[0]) {
+    attrToTruncatedArray(cmd.joinAttrs[1], joinAttributeOne);
+    attrToTruncatedArray(cmd.joinAttrs[0], joinAttributeTwo);
   } else {
     cout << "Syntax Error: Relation names do not match" << endl;
     return FAILURE;
   }
 
-  attrToTruncatedArray(m[6], joinAttributeOne);
-  attrToTruncatedArray(m[8], joinAttributeTwo);
-
-  vector<string> attrTokens = extractTokens(m[1]);
-  int attrCount = attrTokens.size();
+  int attrCount = cmd.attrs.size();
   char attrNames[attrCount][ATTR_SIZE];
   for (int i = 0; i < attrCount; i++) {
-    attrToTruncatedArray(attrTokens[i], attrNames[i]);
+    attrToTruncatedArray(cmd.attrs[i], attrNames[i]);
   }
 
   int ret = Frontend::select_attrlist_from_join_where(sourceRelOneName, sourceRelTwoName, targetRelName,
                                                       joinAttributeOne, joinAttributeTwo, attrCount,
-                                                      attrNames);
+                                                      attrNames, cmd.limit);
   if (ret == SUCCESS) {
-    cout << "Selected successfully into " << targetRelName;
+    cout << "Selected successfully into " << targetRelName << endl;
   }
 
   return ret;
 }
 
-int RegexHandler::customFunctionHandler() {
-  vector<string> tokens = extractTokens(m[1]);
+int CommandHandler::customFunctionHandler() {
+  vector<string> &tokens = cmd.values;
 
   char tokensAsArray[tokens.size()][ATTR_SIZE];
   for (int i = 0; i < tokens.size(); ++i) {
@@ -464,13 +546,24 @@ int RegexHandler::customFunctionHandler() {
   return ret;
 }
 
-int RegexHandler::handle(const string command) {
+int CommandHandler::handle(const string command) {
+  cmd = Command();
+  if (!CommandParser::parse(command, cmd)) {
+    cout << "Syntax Error" << endl;
+    return FAILURE;
+  }
+
   for (auto iter = handlers.begin(); iter != handlers.end(); ++iter) {
-    regex testCommand = iter->first;
     handlerFunction handler = iter->second;
-    if (regex_match(command, testCommand)) {
-      regex_search(command, m, testCommand);
+    if (iter->first == cmd.type) {
       int status = (this->*handler)();
+      // the relations used by the command may be evicted from the cache again
+      OpenRelTable::releaseRelIds();
+      // long sessions can be checkpointed every CHECKPOINT_INTERVAL commands (off by default)
+      if (CHECKPOINT_INTERVAL > 0 && ++commandsSinceCheckpoint >= CHECKPOINT_INTERVAL) {
+        commandsSinceCheckpoint = 0;
+        OpenRelTable::checkpoint();
+      }
       if (status == SUCCESS || status == EXIT) {
         return status;
       }
@@ -482,13 +575,13 @@ int RegexHandler::handle(const string command) {
   return FAILURE;
 }
 
-RegexHandler FrontendInterface::regexHandler;
+CommandHandler FrontendInterface::commandHandler;
 int FrontendInterface::handleFrontend(int argc, char *argv[]) {
   // Taking Run Command as Command Line Argument(if provided)
   if (argc == 3 && strcmp(argv[1], "run") == 0) {
     string run_command("run ");
     run_command.append(argv[2]);
-    int ret = regexHandler.handle(run_command);
+    int ret = commandHandler.handle(run_command);
     if (ret == EXIT) {
       return 0;
     }
@@ -499,7 +592,7 @@ int FrontendInterface::handleFrontend(int argc, char *argv[]) {
     if (strlen(buf) > 0) {
       add_history(buf);
     }
-    int ret = regexHandler.handle(string(buf));
+    int ret = commandHandler.handle(string(buf));
     free(buf);
     if (ret == EXIT) {
       return 0;
@@ -508,24 +601,6 @@ int FrontendInterface::handleFrontend(int argc, char *argv[]) {
   return 0;
 }
 
-// get the operator constant corresponding to the string
-int getOperator(string opStr) {
-  int op = 0;
-  if (opStr == "=")
-    op = EQ;
-  else if (opStr == "<")
-    op = LT;
-  else if (opStr == "<=")
-    op = LE;
-  else if (opStr == ">")
-    op = GT;
-  else if (opStr == ">=")
-    op = GE;
-  else if (opStr == "!=")
-    op = NE;
-  return op;
-}
-
 // truncates a given name string to ATTR_NAME sized char array
 void attrToTruncatedArray(string nameString, char *nameArray) {
   string truncated = nameString.substr(0, ATTR_SIZE - 1);
@@ -579,8 +654,14 @@ void printErrorMsg(int error) {
     cout << "Error: Maximum number of attributes allowed for a relation is 125" << endl;
   else if (error == E_NOTPERMITTED)
     cout << "Error: This operation is not permitted" << endl;
+  else if (error == E_NOTFOUND)
+    cout << "Error: No records found" << endl;
   else if (error == E_INDEX_BLOCKS_RELEASED)
     cout << "Warning: Operation succeeded, but some indexes had to be dropped" << endl;
+  else if (error == E_NULLVALUE)
+    cout << "Error: Null values not allowed in attribute values" << endl;
+  else if (error == E_FILENOTEXIST)
+    cout << "Error: File does not exist" << endl;
 }
 
 void printHelp() {
@@ -592,15 +673,23 @@ void printHelp() {
   printf("DROP INDEX ON tablename.attributename; \n\t-delete the index. \n\n");
   printf("ALTER TABLE RENAME tablename TO new_tablename;\n\t-rename an existing relation to a given new name. \n\n");
   printf("ALTER TABLE RENAME tablename COLUMN column_name TO new_column_name;\n\t-rename an attribute of an existing relation.\n\n");
+  printf("ANALYZE tablename;\n\t-collect statistics of the attributes of an open relation, used to choose between index and linear scans.\n\n");
   printf("INSERT INTO tablename VALUES ( value1,value2,value3,... );\n\t-insert a single record into the given relation. \n\n");
   printf("INSERT INTO tablename VALUES FROM filepath; \n\t-insert multiple records from a csv file \n\n");
+  printf("DELETE FROM tablename [WHERE attr1 OP value1 AND attr2 OP value2 OR ...]; \n\t-delete the records satisfying the condition (every record without WHERE), keeping the indexes up to date \n\n");
+  printf("UPDATE tablename SET attr1 = value1, attr2 = value2, ... [WHERE attr OP value AND ... OR ...]; \n\t-rewrite the records satisfying the condition in place (every record without WHERE), updating only the indexes of the attributes set \n\n");
   printf("SELECT * FROM source_relation INTO target_relation; \n\t-creates a relation with the same attributes and records as of source relation\n\n");
   printf("SELECT Attribute1,Attribute2,....FROM source_relation INTO target_relation; \n\t-creates a relation with attributes specified and all records\n\n");
   printf("SELECT * FROM source_relation INTO target_relation WHERE attrname OP value; \n\t-retrieve records based on a condition and insert them into a target relation\n\n");
+  printf("SELECT * FROM source_relation INTO target_relation WHERE attr1 OP value1 AND attr2 OP value2 OR attr3 OP value3 ...; \n\t-retrieve records satisfying several conditions joined by AND/OR (AND binds tighter than OR)\n\n");
   printf("SELECT Attribute1,Attribute2,....FROM source_relation INTO target_relation;\n\t-creates a relation with the attributes specified and inserts those records which satisfy the given condition.\n\n");
   printf("SELECT * FROM source_relation1 JOIN source_relation2 INTO target_relation WHERE source_relation1.attribute1 = source_relation2.attribute2; \n\t-creates a new relation with by equi-join of both the source relations\n\n");
   printf("SELECT Attribute1,Attribute2,.. FROM source_relation1 JOIN source_relation2 INTO target_relation WHERE source_relation1.attribute1 = source_relation2.attribute2; \n\t-creates a new relation by equi-join of both the source relations with the attributes specified \n\n");
+  printf("SELECT * FROM source_relation INTO target_relation ORDER BY attrname [ASC|DESC] [LIMIT n]; \n\t-creates a relation with the records of the source relation sorted on the given attribute (only the first n with LIMIT)\n\n");
+  printf("... LIMIT n; \n\t-any SELECT or JOIN above may end with LIMIT n to stop after n records\n\n");
+  printf("SELECT MIN(attribute) | MAX(attribute) | COUNT(*) FROM source_relation; \n\t-print the aggregate over the source relation (answered from the B+ tree when the attribute is indexed)\n\n");
   printf("echo <any message> \n\t  -echo back the given string. \n\n");
   printf("run <filename> \n\t  -run commands from an input file in sequence. \n\n");
+  printf("CHECKPOINT; \n\t-write the changes made so far to the disk, so that they survive a crash of the session. \n\n");
   printf("exit \n\t-Exit the interface\n");
 }
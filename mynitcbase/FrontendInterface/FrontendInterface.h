@@ -1,11 +1,11 @@
 #ifndef FRONTEND_INTERFACE_H
 #define FRONTEND_INTERFACE_H
 
-#include "RegexHandler.h"
+#include "CommandHandler.h"
 
 class FrontendInterface {
  private:
-  static RegexHandler regexHandler;
+  static CommandHandler commandHandler;
 
  public:
   static int handleFrontend(int argc, char *argv[]);
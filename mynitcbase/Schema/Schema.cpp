@@ -13,11 +13,13 @@
 #include <cmath>
 #include <cstring>
 
+#include "../Statistics/Statistics.h"
+
 int Schema::openRel(char relName[ATTR_SIZE]) {
 	int ret = OpenRelTable::openRel(relName);
 
 	// the OpenRelTable::openRel() function returns the rel-id if successful
-	// a valid rel-id will be within the range 0 <= relId < MAX_OPEN and any
+	// a valid rel-id is an index of the Open Relation Table and any
 	// error codes will be negative
 	if (ret >= 0) {
 		return SUCCESS;
@@ -35,7 +37,7 @@ int Schema::closeRel(char relName[ATTR_SIZE]) {
 
 	// this function returns the rel-id of a relation if it is open or
 	// E_RELNOTOPEN if it is not. we will implement this later.
-	int relId = OpenRelTable::getRelId(relName);
+	int relId = OpenRelTable::pinRel(relName);
 
 	if (relId == E_RELNOTOPEN) {
 		return E_RELNOTOPEN;
@@ -54,21 +56,28 @@ int Schema::renameRel(char oldRelName[ATTR_SIZE], char newRelName[ATTR_SIZE]) {
 		strcmp(newRelName, RELCAT_RELNAME) == 0 ||
 		strcmp(newRelName, ATTRCAT_RELNAME) == 0 ||
 		strcmp(oldRelName, RELCAT_RELNAME) == 0 ||
-		strcmp(oldRelName, ATTRCAT_RELNAME) == 0
+		strcmp(oldRelName, ATTRCAT_RELNAME) == 0 ||
+		strcmp(newRelName, STATCAT_RELNAME) == 0 ||
+		strcmp(oldRelName, STATCAT_RELNAME) == 0
 		) {
 		return E_NOTPERMITTED;
 	}
 
 	// if the relation is open
-	//    (check if OpenRelTable::getRelId() returns E_RELNOTOPEN)
+	//    (check with OpenRelTable::isOpen(), which does not load the relation)
 	//    return E_RELOPEN
-	int retVal = OpenRelTable::getRelId(oldRelName);
-	if (retVal != E_RELNOTOPEN) {
+	if (OpenRelTable::isOpen(oldRelName)) {
 		return E_RELOPEN;
 	}
 
 	// retVal = BlockAccess::renameRelation(oldRelName, newRelName);
-	retVal = BlockAccess::renameRelation(oldRelName, newRelName);
+	int retVal = BlockAccess::renameRelation(oldRelName, newRelName);
+
+	// the statistics of the relation move with it
+	if (retVal == SUCCESS) {
+		Statistics::renameRel(oldRelName, newRelName);
+	}
+
 	// return retVal
 	return retVal;
 }
@@ -82,30 +91,45 @@ int Schema::renameAttr(char* relName, char* oldAttrName, char* newAttrName) {
 		// you may use the following constants: RELCAT_NAME and ATTRCAT_NAME)
 	if (
 		strcmp(relName, RELCAT_RELNAME) == 0 ||
-		strcmp(relName, ATTRCAT_RELNAME) == 0
+		strcmp(relName, ATTRCAT_RELNAME) == 0 ||
+		strcmp(relName, STATCAT_RELNAME) == 0
 		) {
 		return E_NOTPERMITTED;
 	}
 
 	// if the relation is open
-		//    (check if OpenRelTable::getRelId() returns E_RELNOTOPEN)
+		//    (check with OpenRelTable::isOpen(), which does not load the relation)
 		//    return E_RELOPEN
-	int retVal = OpenRelTable::getRelId(relName);
-	if (retVal != E_RELNOTOPEN) {
+	if (OpenRelTable::isOpen(relName)) {
 		return E_RELOPEN;
 	}
 
 	// Call BlockAccess::renameAttribute with appropriate arguments.
 
+	int retVal = BlockAccess::renameAttribute(relName, oldAttrName, newAttrName);
+
+	// the statistics of the attribute move with it
+	if (retVal == SUCCESS) {
+		Statistics::renameAttr(relName, oldAttrName, newAttrName);
+	}
+
 	// return the value returned by the above renameAttribute() call
-	return BlockAccess::renameAttribute(relName, oldAttrName, newAttrName);
+	return retVal;
 }
 
 /*  creates a new relation with the name, attribute/column list as specified in arguments.
 	Verifying the maximum number of attributes in a relation is to be checked by the caller
 	of this function (Frontend Interface) and is not handled by this function. */
 int Schema::createRel(char relName[], int nAttrs, char attrs[][ATTR_SIZE], int attrtype[]) {
+	// the statistics catalog is created by the Statistics class on the first ANALYZE
+	if (strcmp(relName, STATCAT_RELNAME) == 0) {
+		return E_NOTPERMITTED;
+	}
 
+	return createRelation(relName, nAttrs, attrs, attrtype);
+}
+
+int Schema::createRelation(char relName[], int nAttrs, char attrs[][ATTR_SIZE], int attrtype[]) {
 	// declare variable relNameAsAttribute of type Attribute
 	Attribute relNameAsAttribute;
 	// copy the relName into relNameAsAttribute.sVal
@@ -114,19 +138,11 @@ int Schema::createRel(char relName[], int nAttrs, char attrs[][ATTR_SIZE], int a
 	// declare a variable targetRelId of type RecId
 	RecId targetRelId;
 
-	// Reset the searchIndex using RelCacheTable::resetSearhIndex()
-	// Search the relation catalog (relId given by the constant RELCAT_RELID)
-	// for attribute value attribute "RelName" = relNameAsAttribute using
-	// BlockAccess::linearSearch() with OP = EQ
-	RelCacheTable::resetSearchIndex(RELCAT_RELID);
-
-	// the attribute in which we need to search attrVal (i.e "RelName" = relNameAsAttribute)
-	char searchInAttr[ATTR_SIZE];
-	strcpy(searchInAttr, RELCAT_ATTR_RELNAME);
+	// Look up the relation catalog (relId given by the constant RELCAT_RELID)
+	// for "RelName" = relNameAsAttribute using RelCacheTable::getRelCatRecId()
+	targetRelId = RelCacheTable::getRelCatRecId(relName);
 
-	targetRelId = BlockAccess::linearSearch(RELCAT_RELID, searchInAttr, relNameAsAttribute, EQ);
-
-	// if a relation with name `relName` already exists  ( linearSearch() does
+	// if a relation with name `relName` already exists  ( getRelCatRecId() does
 	//                                                     not return {-1,-1} )
 	//     return E_RELEXIST;
 	if (targetRelId.block != -1 && targetRelId.slot != -1) {
@@ -154,14 +170,14 @@ int Schema::createRel(char relName[], int nAttrs, char attrs[][ATTR_SIZE], int a
 	// offset RELCAT_NO_RECORDS_INDEX: 0
 	// offset RELCAT_FIRST_BLOCK_INDEX: -1
 	// offset RELCAT_LAST_BLOCK_INDEX: -1
-	// offset RELCAT_NO_SLOTS_PER_BLOCK_INDEX: floor((2016 / (16 * nAttrs + 1)))
+	// offset RELCAT_NO_SLOTS_PER_BLOCK_INDEX: floor(((blockSize - 32) / (16 * nAttrs + 1)))
 	// (number of slots is calculated as specified in the physical layer docs)
 	strcpy(relCatRecord[RELCAT_REL_NAME_INDEX].sVal, relName);
 	relCatRecord[RELCAT_NO_ATTRIBUTES_INDEX].nVal = nAttrs;
 	relCatRecord[RELCAT_NO_RECORDS_INDEX].nVal = 0;
 	relCatRecord[RELCAT_FIRST_BLOCK_INDEX].nVal = -1;
 	relCatRecord[RELCAT_LAST_BLOCK_INDEX].nVal = -1;
-	relCatRecord[RELCAT_NO_SLOTS_PER_BLOCK_INDEX].nVal = (BLOCK_SIZE - HEADER_SIZE) / (ATTR_SIZE * nAttrs + 1) ;
+	relCatRecord[RELCAT_NO_SLOTS_PER_BLOCK_INDEX].nVal = (Disk::getBlockSize() - HEADER_SIZE) / (ATTR_SIZE * nAttrs + 1) ;
 
 	// retVal = BlockAccess::insert(RELCAT_RELID(=0), relCatRecord);
 	// if BlockAccess::insert fails return retVal
@@ -219,24 +235,29 @@ int Schema::deleteRel(char* relName) {
 		// you may use the following constants: RELCAT_NAME and ATTRCAT_NAME)
 	if (
 		strcmp(RELCAT_RELNAME, relName) == 0 ||
-		strcmp(ATTRCAT_RELNAME, relName) == 0
+		strcmp(ATTRCAT_RELNAME, relName) == 0 ||
+		strcmp(STATCAT_RELNAME, relName) == 0
 	) {
 		return E_NOTPERMITTED;
 	}
 
-	// get the rel-id using appropriate method of OpenRelTable class by
-	// passing relation name as argument
-	int relId = OpenRelTable::getRelId(relName);
-
 	// if relation is opened in open relation table, return E_RELOPEN
-	if (relId != E_RELNOTOPEN) {
+	// (OpenRelTable::isOpen() does not load the relation)
+	if (OpenRelTable::isOpen(relName)) {
 		return E_RELOPEN;
 	}
 
 	// Call BlockAccess::deleteRelation() with appropriate argument.
 
+	int retVal = BlockAccess::deleteRelation(relName);
+
+	// release the statistics of the relation
+	if (retVal == SUCCESS) {
+		Statistics::deleteRel(relName);
+	}
+
 	// return the value returned by the above deleteRelation() call
-	return BlockAccess::deleteRelation(relName);
+	return retVal;
 
 	/* the only that should be returned from deleteRelation() is E_RELNOTEXIST.
 	   The deleteRelation call may return E_OUTOFBOUND from the call to
@@ -254,16 +275,17 @@ int Schema::createIndex(char relName[ATTR_SIZE],char attrName[ATTR_SIZE]){
         // you may use the following constants: RELCAT_NAME and ATTRCAT_NAME)
 	if (
 		strcmp(relName, RELCAT_RELNAME) == 0 ||
-		strcmp(relName, ATTRCAT_RELNAME) == 0
+		strcmp(relName, ATTRCAT_RELNAME) == 0 ||
+		strcmp(relName, STATCAT_RELNAME) == 0
 	) {
 		return E_NOTPERMITTED;
 	}
 
-    // get the relation's rel-id using OpenRelTable::getRelId() method
-	int relId = OpenRelTable::getRelId(relName);
+    // get the relation's rel-id using OpenRelTable::pinRel() method
+	int relId = OpenRelTable::pinRel(relName);
 
     // if relation is not open in open relation table, return E_RELNOTOPEN
-    // (check if the value returned from getRelId function call = E_RELNOTOPEN)
+    // (check if the value returned from pinRel function call = E_RELNOTOPEN)
 	if (relId == E_RELNOTOPEN) {
 		return E_RELNOTOPEN;
 	}
@@ -280,16 +302,17 @@ int Schema::dropIndex(char *relName, char *attrName) {
         // you may use the following constants: RELCAT_NAME and ATTRCAT_NAME)
 	if (
 		strcmp(relName, RELCAT_RELNAME) == 0 ||
-		strcmp(relName, ATTRCAT_RELNAME) == 0
+		strcmp(relName, ATTRCAT_RELNAME) == 0 ||
+		strcmp(relName, STATCAT_RELNAME) == 0
 	) {
 		return E_NOTPERMITTED;
 	}
 
-    // get the relation's rel-id using OpenRelTable::getRelId() method
-	int relId = OpenRelTable::getRelId(relName);
+    // get the relation's rel-id using OpenRelTable::pinRel() method
+	int relId = OpenRelTable::pinRel(relName);
 
     // if relation is not open in open relation table, return E_RELNOTOPEN
-    // (check if the value returned from getRelId function call = E_RELNOTOPEN)
+    // (check if the value returned from pinRel function call = E_RELNOTOPEN)
 	if (relId == E_RELNOTOPEN) {
 		return E_RELNOTOPEN;
 	}
@@ -15,6 +15,12 @@ class Schema {
   static int renameAttr(char relName[ATTR_SIZE], char oldAttrName[ATTR_SIZE], char newAttrName[ATTR_SIZE]);
   static int openRel(char relName[ATTR_SIZE]);
   static int closeRel(char relName[ATTR_SIZE]);
+
+ private:
+  // createRel() without the check on reserved names, for the catalogs created on demand
+  static int createRelation(char relName[], int numOfAttributes, char attrNames[][ATTR_SIZE], int attrType[]);
+
+  friend class Statistics;
 };
 
 #endif  // NITCBASE_SCHEMA_H
@@ -0,0 +1,567 @@
+#include "Statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../Schema/Schema.h"
+
+/* One row of the statistics catalog, as held in the statistics cache */
+struct StatRow {
+    double numValue;
+    char strValue[ATTR_SIZE];
+    double numRecs;
+    double numDistinct;
+};
+
+/* Statistics of one attribute: the summary row (bucket -1) and the histogram buckets */
+struct AttrStats {
+    StatRow summary;
+    StatRow buckets[STAT_BUCKETS];
+};
+
+// statistics of every analyzed attribute, keyed by {relation name, attribute name};
+// loaded from the statistics catalog on first use and dropped whenever it changes
+static std::map<std::pair<std::string, std::string>, AttrStats> statCache;
+static bool statCacheLoaded = false;
+
+static Attribute rowValue(const StatRow &row, int type) {
+    Attribute value;
+    if (type == NUMBER) {
+        value.nVal = row.numValue;
+    } else {
+        strcpy(value.sVal, row.strValue);
+    }
+    return value;
+}
+
+/* 64-bit hash of an attribute value (FNV-1a followed by a splitmix64 finalizer) */
+static uint64_t hashAttr(Attribute value, int type) {
+    const unsigned char *bytes = (const unsigned char *)&value;
+    int length = sizeof(double);
+    if (type == NUMBER) {
+        // -0.0 and 0.0 are the same value
+        if (value.nVal == 0) {
+            value.nVal = 0;
+        }
+    } else {
+        length = strnlen(value.sVal, ATTR_SIZE);
+    }
+
+    uint64_t hash = 14695981039346656037ULL;
+    for (int i = 0; i < length; i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+    return hash ^ (hash >> 31);
+}
+
+// attribute types of the statistics catalog, in attribute order
+static const int statCatAttrTypes[STATCAT_NO_ATTRS] = {STRING, STRING, NUMBER, NUMBER, STRING, NUMBER, NUMBER};
+
+/* HyperLogLog estimate of the number of distinct values added to `registers` */
+static double hllEstimate(const std::vector<unsigned char> &registers) {
+    int m = registers.size();
+    double sum = 0;
+    int zeros = 0;
+    for (unsigned char rank : registers) {
+        sum += std::ldexp(1.0, -rank);
+        if (rank == 0) {
+            zeros++;
+        }
+    }
+
+    double estimate = (0.7213 / (1 + 1.079 / m)) * m * m / sum;
+
+    // small range correction (linear counting)
+    if (estimate <= 2.5 * m && zeros > 0) {
+        estimate = m * std::log((double)m / zeros);
+    }
+    return estimate;
+}
+
+/* Returns the rel-id of the statistics catalog, opening it (and creating it first if
+   `create` is set) when it is not open. `opened` tells the caller to close it again.
+   A relation named STATISTICSCAT whose attributes are not those of the catalog (one
+   created before the name was reserved) is never used: E_NATTRMISMATCH or
+   E_ATTRTYPEMISMATCH is returned instead. */
+int Statistics::openStatCat(bool create, bool *opened) {
+    char statCatName[ATTR_SIZE];
+    strcpy(statCatName, STATCAT_RELNAME);
+
+    *opened = false;
+    int relId = OpenRelTable::pinRel(statCatName);
+    if (relId >= 0) {
+        int ret = checkStatCat(relId);
+        return ret == SUCCESS ? relId : ret;
+    }
+
+    relId = OpenRelTable::openRel(statCatName);
+    if (relId == E_RELNOTEXIST && create) {
+        char attrNames[STATCAT_NO_ATTRS][ATTR_SIZE] = {
+            STATCAT_ATTR_RELNAME, STATCAT_ATTR_ATTRIBUTE_NAME, STATCAT_ATTR_BUCKET, STATCAT_ATTR_NUM_VALUE,
+            STATCAT_ATTR_STR_VALUE, STATCAT_ATTR_NO_RECORDS, STATCAT_ATTR_NO_DISTINCT};
+        int attrTypes[STATCAT_NO_ATTRS];
+        std::copy(statCatAttrTypes, statCatAttrTypes + STATCAT_NO_ATTRS, attrTypes);
+
+        int ret = Schema::createRelation(statCatName, STATCAT_NO_ATTRS, attrNames, attrTypes);
+        if (ret != SUCCESS) {
+            return ret;
+        }
+        relId = OpenRelTable::openRel(statCatName);
+    }
+
+    if (relId < 0) {
+        return relId;
+    }
+
+    int ret = checkStatCat(relId);
+    if (ret != SUCCESS) {
+        OpenRelTable::closeRel(relId);
+        return ret;
+    }
+
+    *opened = true;
+    return relId;
+}
+
+/* Checks that the open relation relId has the attributes of the statistics catalog */
+int Statistics::checkStatCat(int relId) {
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+    if (relCatEntry.numAttrs != STATCAT_NO_ATTRS) {
+        return E_NATTRMISMATCH;
+    }
+
+    for (int i = 0; i < STATCAT_NO_ATTRS; i++) {
+        AttrCatEntry attrCatEntry;
+        AttrCacheTable::getAttrCatEntry(relId, i, &attrCatEntry);
+        if (attrCatEntry.attrType != statCatAttrTypes[i]) {
+            return E_ATTRTYPEMISMATCH;
+        }
+    }
+    return SUCCESS;
+}
+
+/* Reads every row of the statistics catalog into the statistics cache */
+void Statistics::loadStatCache() {
+    bool opened;
+    int statRelId = openStatCat(false, &opened);
+    if (statRelId < 0) {
+        // (without a statistics catalog there is nothing to load; on any other
+        //  error, such as a full cache, loading is retried on the next call)
+        statCache.clear();
+        statCacheLoaded = (statRelId == E_RELNOTEXIST || statRelId == E_NATTRMISMATCH ||
+                           statRelId == E_ATTRTYPEMISMATCH);
+        return;
+    }
+
+    statCache.clear();
+
+    // a search on the statistics catalog may be in progress; keep its position
+    RecId searchIndex;
+    RelCacheTable::getSearchIndex(statRelId, &searchIndex);
+    RelCacheTable::resetSearchIndex(statRelId);
+
+    Attribute record[STATCAT_NO_ATTRS];
+    while (BlockAccess::project(statRelId, record) == SUCCESS) {
+        if (record[STATCAT_REL_NAME_INDEX].sVal[0] == '\0') {
+            continue;  // (a free row)
+        }
+
+        StatRow row;
+        row.numValue = record[STATCAT_NUM_VALUE_INDEX].nVal;
+        strcpy(row.strValue, record[STATCAT_STR_VALUE_INDEX].sVal);
+        row.numRecs = record[STATCAT_NO_RECORDS_INDEX].nVal;
+        row.numDistinct = record[STATCAT_NO_DISTINCT_INDEX].nVal;
+
+        AttrStats &attrStats = statCache[{record[STATCAT_REL_NAME_INDEX].sVal, record[STATCAT_ATTR_NAME_INDEX].sVal}];
+        int bucket = (int)record[STATCAT_BUCKET_INDEX].nVal;
+        if (bucket == -1) {
+            attrStats.summary = row;
+        } else if (bucket >= 0 && bucket < STAT_BUCKETS) {
+            attrStats.buckets[bucket] = row;
+        }
+    }
+
+    RelCacheTable::setSearchIndex(statRelId, &searchIndex);
+    if (opened) {
+        OpenRelTable::closeRel(statRelId);
+    }
+
+    statCacheLoaded = true;
+}
+
+/* Computes the statistics of every attribute of an open relation in a single scan and
+   stores them in the statistics catalog: record count, HyperLogLog distinct count,
+   minimum, and an equi-depth histogram built from a reservoir sample of the values. */
+int Statistics::analyze(char relName[ATTR_SIZE]) {
+    // the statistics catalog cannot be analyzed while it is being written
+    if (strcmp(relName, STATCAT_RELNAME) == 0) {
+        return E_NOTPERMITTED;
+    }
+
+    int relId = OpenRelTable::pinRel(relName);
+    if (relId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+    int nAttrs = relCatEntry.numAttrs;
+
+    AttrCatEntry attrCatEntries[nAttrs];
+    for (int i = 0; i < nAttrs; i++) {
+        AttrCacheTable::getAttrCatEntry(relId, i, &attrCatEntries[i]);
+    }
+
+    /*** Scan the relation once, collecting the statistics of all attributes ***/
+    std::vector<std::vector<unsigned char>> registers(nAttrs, std::vector<unsigned char>(1 << STAT_HLL_BITS, 0));
+    std::vector<std::vector<Attribute>> samples(nAttrs);
+    std::vector<Attribute> minVal(nAttrs), maxVal(nAttrs);
+    memset(minVal.data(), 0, nAttrs * sizeof(Attribute));
+    memset(maxVal.data(), 0, nAttrs * sizeof(Attribute));
+
+    // fixed seed: analyzing the same relation twice gives the same histogram
+    std::mt19937_64 rng(relCatEntry.numRecs);
+    long long numRecs = 0;
+
+    Attribute record[nAttrs];
+    RelCacheTable::resetSearchIndex(relId);
+
+    while (BlockAccess::project(relId, record) == SUCCESS) {
+        numRecs++;
+
+        // reservoir sampling; the same records are sampled for every attribute
+        long long sampleSlot = numRecs - 1;
+        if (numRecs > STAT_SAMPLE_SIZE) {
+            sampleSlot = std::uniform_int_distribution<long long>(0, numRecs - 1)(rng);
+        }
+
+        for (int i = 0; i < nAttrs; i++) {
+            int type = attrCatEntries[i].attrType;
+
+            uint64_t hash = hashAttr(record[i], type);
+            int registerNum = hash >> (64 - STAT_HLL_BITS);
+            uint64_t rest = hash << STAT_HLL_BITS;
+            unsigned char rank = rest == 0 ? 64 - STAT_HLL_BITS + 1 : __builtin_clzll(rest) + 1;
+            registers[i][registerNum] = std::max(registers[i][registerNum], rank);
+
+            if (numRecs == 1 || compareAttrs(record[i], minVal[i], type) < 0) {
+                minVal[i] = record[i];
+            }
+            if (numRecs == 1 || compareAttrs(record[i], maxVal[i], type) > 0) {
+                maxVal[i] = record[i];
+            }
+
+            if (numRecs <= STAT_SAMPLE_SIZE) {
+                samples[i].push_back(record[i]);
+            } else if (sampleSlot < STAT_SAMPLE_SIZE) {
+                samples[i][sampleSlot] = record[i];
+            }
+        }
+    }
+
+    /*** Find the rows already holding statistics of relName ***/
+    bool opened;
+    int statRelId = openStatCat(true, &opened);
+    if (statRelId < 0) {
+        return statRelId;
+    }
+
+    std::map<std::pair<std::string, int>, RecId> existingRows;
+    std::vector<RecId> freeRows;
+
+    Attribute statRecord[STATCAT_NO_ATTRS];
+    RelCacheTable::resetSearchIndex(statRelId);
+    while (BlockAccess::project(statRelId, statRecord) == SUCCESS) {
+        // (project() leaves the rec-id of the record in the search index)
+        RecId recId;
+        RelCacheTable::getSearchIndex(statRelId, &recId);
+
+        if (strcmp(statRecord[STATCAT_REL_NAME_INDEX].sVal, relName) == 0) {
+            existingRows[{statRecord[STATCAT_ATTR_NAME_INDEX].sVal, (int)statRecord[STATCAT_BUCKET_INDEX].nVal}] = recId;
+        } else if (statRecord[STATCAT_REL_NAME_INDEX].sVal[0] == '\0') {
+            freeRows.push_back(recId);
+        }
+    }
+
+    // rows are rewritten in place where possible, then free rows are reused
+    auto writeRow = [&](Attribute row[STATCAT_NO_ATTRS]) {
+        auto existing = existingRows.find({row[STATCAT_ATTR_NAME_INDEX].sVal, (int)row[STATCAT_BUCKET_INDEX].nVal});
+        RecId recId;
+        if (existing != existingRows.end()) {
+            recId = existing->second;
+            existingRows.erase(existing);
+        } else if (!freeRows.empty()) {
+            recId = freeRows.back();
+            freeRows.pop_back();
+        } else {
+            return BlockAccess::insert(statRelId, row);
+        }
+        RecBuffer recBlock(recId.block);
+        return recBlock.setRecord(row, recId.slot);
+    };
+
+    /*** Build the histogram of every attribute and write its rows ***/
+    int ret = SUCCESS;
+    for (int i = 0; i < nAttrs && ret == SUCCESS; i++) {
+        int type = attrCatEntries[i].attrType;
+        std::vector<Attribute> &sample = samples[i];
+        std::sort(sample.begin(), sample.end(), [type](const Attribute &a, const Attribute &b) {
+            return compareAttrs(a, b, type) < 0;
+        });
+
+        Attribute row[STATCAT_NO_ATTRS];
+        memset(row, 0, sizeof(row));
+        strcpy(row[STATCAT_REL_NAME_INDEX].sVal, relName);
+        strcpy(row[STATCAT_ATTR_NAME_INDEX].sVal, attrCatEntries[i].attrName);
+
+        auto setValue = [&](Attribute value) {
+            row[STATCAT_NUM_VALUE_INDEX].nVal = 0;
+            row[STATCAT_STR_VALUE_INDEX].sVal[0] = '\0';
+            if (type == NUMBER) {
+                row[STATCAT_NUM_VALUE_INDEX].nVal = value.nVal;
+            } else {
+                strcpy(row[STATCAT_STR_VALUE_INDEX].sVal, value.sVal);
+            }
+        };
+
+        // summary row: minimum, number of records and number of distinct values
+        row[STATCAT_BUCKET_INDEX].nVal = -1;
+        setValue(minVal[i]);
+        row[STATCAT_NO_RECORDS_INDEX].nVal = numRecs;
+        row[STATCAT_NO_DISTINCT_INDEX].nVal = std::min((double)numRecs, std::round(hllEstimate(registers[i])));
+        ret = writeRow(row);
+
+        // equi-depth buckets; a bucket is extended over all copies of its upper bound,
+        // so that the buckets never overlap (a few trailing buckets may end up empty)
+        int sampleSize = sample.size();
+        int start = 0;
+        Attribute upper = minVal[i];
+        for (int bucket = 0; bucket < STAT_BUCKETS && ret == SUCCESS; bucket++) {
+            int end = std::max(start, (int)((long long)(bucket + 1) * sampleSize / STAT_BUCKETS));
+            if (bucket == STAT_BUCKETS - 1) {
+                end = sampleSize;
+            }
+            while (end > start && end < sampleSize && compareAttrs(sample[end], sample[end - 1], type) == 0) {
+                end++;
+            }
+
+            int distinct = 0;
+            for (int j = start; j < end; j++) {
+                if (j == start || compareAttrs(sample[j], sample[j - 1], type) != 0) {
+                    distinct++;
+                }
+            }
+
+            if (end > start) {
+                upper = sample[end - 1];
+            }
+            if (bucket == STAT_BUCKETS - 1) {
+                // (the maximum may not be in the sample)
+                upper = maxVal[i];
+            }
+
+            row[STATCAT_BUCKET_INDEX].nVal = bucket;
+            setValue(upper);
+            row[STATCAT_NO_RECORDS_INDEX].nVal = sampleSize > 0 ? (double)(end - start) * numRecs / sampleSize : 0;
+            row[STATCAT_NO_DISTINCT_INDEX].nVal = distinct;
+            ret = writeRow(row);
+
+            start = end;
+        }
+    }
+
+    // release the rows of attributes that no longer exist in relName
+    for (auto &existing : existingRows) {
+        RecBuffer recBlock(existing.second.block);
+        recBlock.getRecord(statRecord, existing.second.slot);
+        statRecord[STATCAT_REL_NAME_INDEX].sVal[0] = '\0';
+        recBlock.setRecord(statRecord, existing.second.slot);
+    }
+
+    if (opened) {
+        OpenRelTable::closeRel(statRelId);
+    }
+
+    statCacheLoaded = false;
+
+    return ret;
+}
+
+/* Estimates the number of records of the relation satisfying `attrName op attrVal` from
+   the histogram of the attribute. Returns E_NOTFOUND if the attribute was never analyzed. */
+int Statistics::estimateMatches(int relId, char attrName[ATTR_SIZE], Attribute attrVal, int op, double *matches) {
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+
+    AttrCatEntry attrCatEntry;
+    int ret = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (ret != SUCCESS) {
+        return ret;
+    }
+
+    if (!statCacheLoaded) {
+        loadStatCache();
+    }
+
+    auto found = statCache.find({relCatEntry.relName, attrName});
+    if (found == statCache.end() || found->second.summary.numRecs <= 0) {
+        return E_NOTFOUND;
+    }
+    const AttrStats &attrStats = found->second;
+    int type = attrCatEntry.attrType;
+
+    // the sample under-counts the distinct values of a bucket; scale the bucket counts
+    // so that together they agree with the HyperLogLog estimate for the relation
+    double sampleDistinct = 0;
+    for (int bucket = 0; bucket < STAT_BUCKETS; bucket++) {
+        sampleDistinct += attrStats.buckets[bucket].numDistinct;
+    }
+    double distinctScale = sampleDistinct > 0 ? std::max(1.0, attrStats.summary.numDistinct / sampleDistinct) : 1;
+
+    /* Find the records below attrVal (lt) and equal to attrVal (eq). Bucket i holds the
+       values in (upper bound of bucket i-1, upper bound of bucket i]; bucket 0 starts
+       at the minimum. Within a bucket, NUMBER values are assumed to be spread evenly. */
+    double lt = 0, eq = 0;
+    Attribute lower = rowValue(attrStats.summary, type);
+    if (compareAttrs(attrVal, lower, type) >= 0) {
+        for (int bucket = 0; bucket < STAT_BUCKETS; bucket++) {
+            const StatRow &row = attrStats.buckets[bucket];
+            Attribute upper = rowValue(row, type);
+
+            if (compareAttrs(attrVal, upper, type) > 0) {
+                lt += row.numRecs;
+                lower = upper;
+                continue;
+            }
+
+            // (attrVal falls in this bucket)
+            if (row.numRecs > 0) {
+                eq = row.numRecs / std::max(1.0, row.numDistinct * distinctScale);
+
+                double fraction = 0.5;
+                if (compareAttrs(attrVal, upper, type) == 0) {
+                    fraction = (row.numRecs - eq) / row.numRecs;
+                } else if (type == NUMBER && upper.nVal > lower.nVal) {
+                    fraction = (attrVal.nVal - lower.nVal) / (upper.nVal - lower.nVal);
+                }
+                lt += fraction * row.numRecs;
+            }
+            break;
+        }
+    }
+
+    double total = attrStats.summary.numRecs;
+    double estimate = 0;
+    switch (op) {
+        case EQ: estimate = eq; break;
+        case LT: estimate = lt; break;
+        case LE: estimate = lt + eq; break;
+        case GT: estimate = total - lt - eq; break;
+        case GE: estimate = total - lt; break;
+        case NE: estimate = total - eq; break;
+    }
+
+    // the relation may have grown or shrunk since it was analyzed
+    *matches = std::max(0.0, estimate) * relCatEntry.numRecs / total;
+
+    return SUCCESS;
+}
+
+/* Rewrites the relation and attribute names of the matching statistics catalog rows.
+   A null attribute name matches every attribute of the relation, and an empty new
+   relation name releases the rows for reuse. */
+static int renameRows(char relName[ATTR_SIZE], char attrName[ATTR_SIZE], char newRelName[ATTR_SIZE],
+                      char newAttrName[ATTR_SIZE], int statRelId) {
+    RecId searchIndex;
+    RelCacheTable::getSearchIndex(statRelId, &searchIndex);
+    RelCacheTable::resetSearchIndex(statRelId);
+
+    Attribute record[STATCAT_NO_ATTRS];
+    while (BlockAccess::project(statRelId, record) == SUCCESS) {
+        if (strcmp(record[STATCAT_REL_NAME_INDEX].sVal, relName) != 0 ||
+            (attrName != nullptr && strcmp(record[STATCAT_ATTR_NAME_INDEX].sVal, attrName) != 0)) {
+            continue;
+        }
+
+        RecId recId;
+        RelCacheTable::getSearchIndex(statRelId, &recId);
+
+        strcpy(record[STATCAT_REL_NAME_INDEX].sVal, newRelName);
+        if (newAttrName != nullptr) {
+            strcpy(record[STATCAT_ATTR_NAME_INDEX].sVal, newAttrName);
+        }
+
+        RecBuffer recBlock(recId.block);
+        recBlock.setRecord(record, recId.slot);
+    }
+
+    RelCacheTable::setSearchIndex(statRelId, &searchIndex);
+    return SUCCESS;
+}
+
+int Statistics::renameRel(char oldRelName[ATTR_SIZE], char newRelName[ATTR_SIZE]) {
+    if (!statCacheLoaded) {
+        loadStatCache();
+    }
+
+    // nothing to do unless the relation has been analyzed
+    auto found = statCache.lower_bound({oldRelName, ""});
+    if (found == statCache.end() || found->first.first != oldRelName) {
+        return SUCCESS;
+    }
+
+    bool opened;
+    int statRelId = openStatCat(false, &opened);
+    if (statRelId < 0) {
+        return statRelId;
+    }
+
+    renameRows(oldRelName, nullptr, newRelName, nullptr, statRelId);
+
+    if (opened) {
+        OpenRelTable::closeRel(statRelId);
+    }
+    statCacheLoaded = false;
+
+    return SUCCESS;
+}
+
+int Statistics::renameAttr(char relName[ATTR_SIZE], char oldAttrName[ATTR_SIZE], char newAttrName[ATTR_SIZE]) {
+    if (!statCacheLoaded) {
+        loadStatCache();
+    }
+
+    if (statCache.find({relName, oldAttrName}) == statCache.end()) {
+        return SUCCESS;
+    }
+
+    bool opened;
+    int statRelId = openStatCat(false, &opened);
+    if (statRelId < 0) {
+        return statRelId;
+    }
+
+    renameRows(relName, oldAttrName, relName, newAttrName, statRelId);
+
+    if (opened) {
+        OpenRelTable::closeRel(statRelId);
+    }
+    statCacheLoaded = false;
+
+    return SUCCESS;
+}
+
+int Statistics::deleteRel(char relName[ATTR_SIZE]) {
+    char freeRowName[ATTR_SIZE] = "";
+    return renameRel(relName, freeRowName);
+}
@@ -0,0 +1,29 @@
+#ifndef NITCBASE_STATISTICS_H
+#define NITCBASE_STATISTICS_H
+
+#include "../BlockAccess/BlockAccess.h"
+#include "../Cache/OpenRelTable.h"
+#include "../define/constants.h"
+#include "../define/id.h"
+
+#define STAT_BUCKETS 16        // Number of buckets in the equi-depth histogram of an attribute
+#define STAT_SAMPLE_SIZE 4096  // Number of values sampled per attribute to build the histogram
+#define STAT_HLL_BITS 10       // log2 of the number of HyperLogLog registers per attribute
+
+class Statistics {
+ public:
+  static int analyze(char relName[ATTR_SIZE]);
+  static int estimateMatches(int relId, char attrName[ATTR_SIZE], Attribute attrVal, int op, double *matches);
+
+  // keep the statistics catalog in step with the DDL on a relation
+  static int renameRel(char oldRelName[ATTR_SIZE], char newRelName[ATTR_SIZE]);
+  static int renameAttr(char relName[ATTR_SIZE], char oldAttrName[ATTR_SIZE], char newAttrName[ATTR_SIZE]);
+  static int deleteRel(char relName[ATTR_SIZE]);
+
+ private:
+  static int openStatCat(bool create, bool *opened);
+  static int checkStatCat(int relId);
+  static void loadStatCache();
+};
+
+#endif  // NITCBASE_STATISTICS_H
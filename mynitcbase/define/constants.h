@@ -8,7 +8,9 @@
 #define OUTPUT_FILES_PATH "../Files/Output_Files/"          // Path to Output_Files directory inside the Files directory
 #define BATCH_FILES_PATH "../Files/Batch_Execution_Files/"  // Path to Batch_Execution_Files directory inside the Files directory
 
-#define BLOCK_SIZE 2048             // Size of Block in bytes
+#define BLOCK_SIZE 2048             // Size of Block in bytes of a disk without a superblock (the default block size)
+#define MIN_BLOCK_SIZE 2048         // Smallest block size of a disk
+#define MAX_BLOCK_SIZE 16384        // Largest block size of a disk
 #define ATTR_SIZE 16                // Size of an attribute in bytes
 #define DISK_SIZE 16 * 1024 * 1024  // Size of Disk in bytes
 #define HEADER_SIZE 32              // Size of Header of a block in bytes (not including slotmap)
@@ -21,13 +23,21 @@
 #define INTERNAL_ENTRY_SIZE 24      // Size of an Internal Index Entry in the Internal Index Block (in bytes)
 #define LEAF_ENTRY_SIZE 32          // Size of an Leaf Index Entry in the Leaf Index Block (in bytes)
 
-#define DISK_BLOCKS 8192             // Number of block in disk
+#define DISK_BLOCKS 8192             // Number of block in a disk without a superblock (the default disk size)
 #define BUFFER_CAPACITY 32           // Total number of blocks available in the Buffer (Capacity of the Buffer in blocks)
-#define MAX_OPEN 12                  // Maximum number of relations allowed to be open and cached in Cache Layer.
-#define BLOCK_ALLOCATION_MAP_SIZE 4  // Number of blocks given for Block Allocation Map in the disk
+#define MAX_OPEN 64                  // Number of relations kept cached in Cache Layer before unused ones are evicted (the cache grows when all are in use)
+#define BLOCK_ALLOCATION_MAP_SIZE 4  // Number of blocks given for Block Allocation Map in a disk without a superblock
+#define EXTENT_BLOCKS 64             // Number of blocks in an extent of the block allocator (a relation or index grows within one extent before taking another)
+#define MAX_RESERVED_BLOCKS 64       // Maximum number of record blocks preallocated at a time for a growing relation
+#define CHECKPOINT_INTERVAL 0        // Number of commands after which the changes of the session are checkpointed to the disk (0 to checkpoint only on CHECKPOINT and exit)
+
+#define SUPERBLOCK 0                  // Disk block number of the superblock, which records the size of the disk
+#define DISK_MAGIC "NITCBASE"         // Magic bytes at the start of the superblock
+#define BLOCK_ALLOCATION_MAP_BLOCK 6  // Disk block number of the first block of the Block Allocation Map (after the catalogs)
 
 #define RELCAT_NO_ATTRS 6   // Number of attributes present in one entry / record of the Relation Catalog
 #define ATTRCAT_NO_ATTRS 6  // Number of attributes present in one entry / record of the Attribute Catalog
+#define STATCAT_NO_ATTRS 7  // Number of attributes present in one entry / record of the Statistics Catalog
 
 #define RELCAT_BLOCK 4   // Disk block number for the block of Relation Catalog
 #define ATTRCAT_BLOCK 5  // Disk block number for the first block of Attribute Catalog
@@ -60,12 +70,24 @@ enum ConditionalOperators {
   NE   // !=
 };
 
+enum AccessPath {
+  LINEAR_SCAN,  // scan every record block of the relation
+  INDEX_SCAN    // walk the B+ tree leaves and fetch the matching records
+};
+
+enum AggregateOperators {
+  AGG_MIN,   // MIN(attr)
+  AGG_MAX,   // MAX(attr)
+  AGG_COUNT  // COUNT(*)
+};
+
 enum BlockType {
   REC,           // record block
   IND_INTERNAL,  // internal index block
   IND_LEAF,      // leaf index block
   UNUSED_BLK,    // unused block
-  BMAP           // block allocation map
+  BMAP,          // block allocation map
+  RESERVED_BLK   // unused block preallocated for an open relation (only in memory, freed when the relation is closed)
 };
 
 enum OpenRelationEntryStatus {
@@ -93,6 +115,17 @@ enum AttrCatFieldIndex {
   ATTRCAT_OFFSET_INDEX = 5         // Offset
 };
 
+// Indexes for Statistics Catalog Attributes
+enum StatCatFieldIndex {
+  STATCAT_REL_NAME_INDEX = 0,     // Relation Name
+  STATCAT_ATTR_NAME_INDEX = 1,    // Attribute Name
+  STATCAT_BUCKET_INDEX = 2,       // Histogram bucket (-1 for the attribute summary)
+  STATCAT_NUM_VALUE_INDEX = 3,    // Bucket upper bound (minimum for the summary) of a NUMBER attribute
+  STATCAT_STR_VALUE_INDEX = 4,    // Bucket upper bound (minimum for the summary) of a STRING attribute
+  STATCAT_NO_RECORDS_INDEX = 5,   // Records in the bucket (in the relation for the summary)
+  STATCAT_NO_DISTINCT_INDEX = 6   // Distinct values in the bucket sample (HyperLogLog estimate for the summary)
+};
+
 enum ReturnTypes {
   SUCCESS = 0,
   FAILURE = -1,
@@ -119,20 +152,24 @@ enum ReturnTypes {
   E_NOTFOUND,               // Search for requested record unsuccessful
   E_BLOCKNOTINBUFFER,       // Block not found in buffer
   E_INDEX_BLOCKS_RELEASED,  // Due to insufficient disk space, index blocks have been released from the disk
+  E_NULLVALUE,              // Null values not allowed in attribute values
+  E_FILENOTEXIST,           // File does not exist
 };
 
 #define TEMP ".temp"  // Used for internal purposes
 
-// Global variables for B+ Tree Layer
-#define MAX_KEYS_INTERNAL 100     // Maximum number of keys allowed in an Internal Node of a B+ tree
-#define MIDDLE_INDEX_INTERNAL 50  // Index of the middle element in an Internal Node of a B+ tree
-#define MAX_KEYS_LEAF 63          // Maximum number of keys allowed in a Leaf Node of a B+ tree
-#define MIDDLE_INDEX_LEAF 31      // Index of the middle element in a Leaf Node of a B+ tree
+#define NO_LIMIT -1  // Row limit of a query without a LIMIT clause
+
+#define CSV_CHUNK_MIN 65536  // Smallest part of a csv file parsed by a thread of a bulk insert
+#define BULK_INSERT_BATCH 4096  // Records queued by an operator before they are appended to its target relation
 
 // Name strings for Relation Catalog and Attribute Catalog (as it is stored in the Relation catalog)
 #define RELCAT_RELNAME "RELATIONCAT"
 #define ATTRCAT_RELNAME "ATTRIBUTECAT"
 
+// Name string for the Statistics Catalog (created by the first ANALYZE)
+#define STATCAT_RELNAME "STATISTICSCAT"
+
 // Relation Catalog attribute name strings
 #define RELCAT_ATTR_RELNAME "RelName"
 #define RELCAT_ATTR_NO_ATTRIBUTES "#Attributes"
@@ -149,4 +186,13 @@ enum ReturnTypes {
 #define ATTRCAT_ATTR_ROOT_BLOCK "RootBlock"
 #define ATTRCAT_ATTR_OFFSET "Offset"
 
+// Statistics Catalog attribute name strings
+#define STATCAT_ATTR_RELNAME "RelName"
+#define STATCAT_ATTR_ATTRIBUTE_NAME "AttributeName"
+#define STATCAT_ATTR_BUCKET "Bucket"
+#define STATCAT_ATTR_NUM_VALUE "NumValue"
+#define STATCAT_ATTR_STR_VALUE "StrValue"
+#define STATCAT_ATTR_NO_RECORDS "#Records"
+#define STATCAT_ATTR_NO_DISTINCT "#Distinct"
+
 #endif  // NITCBASE_CONSTANTS_H
\ No newline at end of file